@@ -215,6 +215,8 @@ int main(int argc, char** argv)
 		cout << "\tc lf <FixPolarityLit> <OnlyOnce>" << endl;
 		cout << "\tc ll <LitToCreateInternalLit>" << endl;
 		cout << "\tc lc <ClearUserPolarityInfoLit>" << endl;
+		cout << "\tc lz <FreezeLit>" << endl;
+		cout << "\tc lm <MeltLit>" << endl;
 		cout << "\tc b <BacktrackLevel>" << endl;
 		cout << "\tc n <ConfigNumber>" << endl;
 		cout << "\tc s <Lit1 <Lit2> ... <Litn>: solve under the assumptions {<Lit1 <Lit2> ... <Litn>}" << endl;
@@ -395,6 +397,18 @@ int main(int argc, char** argv)
 		topor32 ? topor32->CreateInternalLit(v) : topor64 ? topor64->CreateInternalLit(v) : toporc->CreateInternalLit(v);
 	};
 
+	auto ToporFreeze = [&](TLit l)
+	{
+		assert(!AllToporsNull());
+		topor32 ? topor32->Freeze(l) : topor64 ? topor64->Freeze(l) : toporc->Freeze(l);
+	};
+
+	auto ToporMelt = [&](TLit l)
+	{
+		assert(!AllToporsNull());
+		topor32 ? topor32->Melt(l) : topor64 ? topor64->Melt(l) : toporc->Melt(l);
+	};
+
 	auto ToporBoostScore = [&](TLit v, double value = 1.0)
 	{
 		assert(!AllToporsNull());
@@ -1118,9 +1132,11 @@ int main(int argc, char** argv)
 			// cout << "\tc lf <FixPolarityLit> <OnlyOnce>" << endl;
 			// cout << "\tc lc <ClearUserPolarityInfoLit>" << endl;
 			// cout << "\tc ll <LitToCreateInternalLit>" << endl;
-			if (lStr[1] != 'b' && lStr[1] != 'f' && lStr[1] != 'c' && lStr[1] != 'l')
+			// cout << "\tc lz <FreezeLit>" << endl;
+			// cout << "\tc lm <MeltLit>" << endl;
+			if (lStr[1] != 'b' && lStr[1] != 'f' && lStr[1] != 'c' && lStr[1] != 'l' && lStr[1] != 'z' && lStr[1] != 'm')
 			{
-				throw logic_error("c topor_tool ERROR: The 2nd character must be either b or f or c at line number " + to_string(lineNum));
+				throw logic_error("c topor_tool ERROR: The 2nd character must be either b or f or c or l or z or m at line number " + to_string(lineNum));
 			}
 
 			if (lStr[2] != ' ')
@@ -1158,6 +1174,14 @@ int main(int argc, char** argv)
 			{
 				ToporCreateInternalLit(lit);
 			}
+			else if (lStr[1] == 'z')
+			{
+				ToporFreeze(lit);
+			}
+			else if (lStr[1] == 'm')
+			{
+				ToporMelt(lit);
+			}
 			else
 			{
 				assert(lStr[1] == 'b');
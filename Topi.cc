@@ -121,11 +121,11 @@ void CTopi<TLit, TUInd, Compress>::ReadAnyParamsFromFile()
 
 template <typename TLit, typename TUInd, bool Compress>
 CTopi<TLit, TUInd, Compress>::CTopi(TLit varNumHint) : m_InitVarNumAlloc(varNumHint <= 0 ? InitEntriesInB : (size_t)varNumHint + 1), m_E2ILitMap(m_InitVarNumAlloc, (size_t)0),
-m_HandleNewUserCls(m_InitVarNumAlloc), m_Watches(GetInitLitNumAlloc(), (size_t)0), m_TrailLastVarPerDecLevel(1, BadClsInd),
+m_HandleNewUserCls(m_InitVarNumAlloc), m_Watches(GetInitLitNumAlloc(), (size_t)0), m_TrailDecLevelStart(1, 0),
 m_VarInfo(m_InitVarNumAlloc, (size_t)0),
 m_Stat([&]() { return Compress ? m_BC.size() : 1; }, [&]() { return Compress ? BCCapacitySum() : m_B.cap(); }, [&]() { return Compress ? BCNextBitSum() / 64 + 1 : m_BNext; }, [&]() { return GetMemoryLayout(); }, m_ParamVarActivityInc), m_VsidsHeap(m_Stat.m_VarActivityInc)
 {
-	m_AssignmentInfo.reserve_exactly(m_InitVarNumAlloc, (size_t)0);
+	m_AssignmentInfo.reserve_exactly(AssignmentInfoCap(m_InitVarNumAlloc), (size_t)0);
 
 	static bool diamondInvokedTopor = false;
 	DIAMOND("topor", diamondInvokedTopor);
@@ -162,9 +162,9 @@ m_Stat([&]() { return Compress ? m_BC.size() : 1; }, [&]() { return Compress ? B
 	{
 		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "CTopi<TLit,TUInd,Compress>::CTopi: couldn't allocate m_VarInfo");
 	}
-	else if (m_TrailLastVarPerDecLevel.uninitialized_or_erroneous())
+	else if (m_TrailDecLevelStart.uninitialized_or_erroneous())
 	{
-		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "CTopi<TLit,TUInd,Compress>::CTopi: couldn't allocate m_TrailLastVarPerDecLevel");
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "CTopi<TLit,TUInd,Compress>::CTopi: couldn't allocate m_TrailDecLevelStart");
 	}
 
 	SetMultipliers();
@@ -221,6 +221,11 @@ void CTopi<TLit, TUInd, Compress>::SetParam(const string& paramName, double newV
 	{
 		m_VsidsHeap.SetInitOrder(m_ParamVsidsInitOrder);
 	}
+
+	if (IsWLInlineClsInfoParam(paramName))
+	{
+		WLInlineClsInfoInit();
+	}
 }
 
 template <typename TLit, typename TUInd, bool Compress>
@@ -319,6 +324,14 @@ void CTopi<TLit, TUInd, Compress>::HandleIncomingUserVar(TLit v, bool isUndoable
 				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "HandleIncomingUserVar: couldn't insert into m_VsidsHeap");
 				return;
 			}
+
+			m_Vmtf.enqueue(m_LastExistingVar);
+
+			if (unlikely(m_Vmtf.uninitialized_or_erroneous()))
+			{
+				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "HandleIncomingUserVar: couldn't enqueue into m_Vmtf");
+				return;
+			}
 		}
 		else
 		{
@@ -330,9 +343,9 @@ void CTopi<TLit, TUInd, Compress>::HandleIncomingUserVar(TLit v, bool isUndoable
 			}
 		}
 
-		if (unlikely(m_LastExistingVar >= m_AssignmentInfo.cap()))
+		if (unlikely(AssignmentInfoCap(GetNextVar()) > m_AssignmentInfo.cap()))
 		{
-			m_AssignmentInfo.reserve_atleast(GetNextVar(), (size_t)0);
+			m_AssignmentInfo.reserve_atleast(AssignmentInfoCap(GetNextVar()), (size_t)0);
 			if (unlikely(m_AssignmentInfo.uninitialized_or_erroneous()))
 			{
 				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "HandleIncomingUserVar: couldn't realloc m_AssignmentInfo");
@@ -349,6 +362,17 @@ void CTopi<TLit, TUInd, Compress>::HandleIncomingUserVar(TLit v, bool isUndoable
 				return;
 			}
 		}
+
+		// Assign updates LRB's information of the new variable, even if it's assigned before the next Solve reserves the variable data
+		if (unlikely(IsLrbUsed() && m_LastExistingVar >= m_LrbInfo.cap()))
+		{
+			m_LrbInfo.reserve_atleast(GetNextVar(), (size_t)0);
+			if (unlikely(m_LrbInfo.uninitialized_or_erroneous()))
+			{
+				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "HandleIncomingUserVar: couldn't realloc m_LrbInfo");
+				return;
+			}
+		}
 	}
 
 	m_Stat.m_MaxUserVar = max(m_Stat.m_MaxUserVar, v);
@@ -376,7 +400,13 @@ void CTopi<TLit, TUInd, Compress>::DumpSpan(const span<TLit> c, const string& pr
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit, TUInd, Compress>::AddUserClause(const span<TLit> c)
 {
-	if (m_DumpFile && !m_ParamDontDumpClauses) DumpSpan(c, "", " 0");
+	if (m_DumpFile && !m_ParamDontDumpClauses && !m_BveIsRestoring) DumpSpan(c, "", " 0");
+
+	if (BveIsAnyEliminated(c))
+	{
+		// The clause contains an eliminated variable, hence all the eliminated variables are brought back first
+		BveRestoreAll();
+	}
 
 	AssumpUnsatCoreCleanUpIfRequired();
 
@@ -403,6 +433,14 @@ void CTopi<TLit, TUInd, Compress>::AddUserClause(const span<TLit> c)
 					SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "AddUserClause: couldn't insert into m_VsidsHeap");
 					return;
 				}
+
+				m_Vmtf.enqueue(GetVar(m_E2ILitMap[ev]));
+
+				if (unlikely(m_Vmtf.uninitialized_or_erroneous()))
+				{
+					SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "AddUserClause: couldn't enqueue into m_Vmtf");
+					return;
+				}
 			}
 
 			if (boostScores)
@@ -556,11 +594,12 @@ void CTopi<TLit, TUInd, Compress>::AddUserClause(const span<TLit> c)
 		return;
 	}
 
-	if (cls.size() == 1 && m_NewExternalVarsAddUserCls.size() == 1 && m_TrailStart != BadUVar && GetAssignedDecLevelVar(m_TrailStart) == 0 && (!IsAssigned(cls[0]) || GetAssignedDecLevel(cls[0]) != 0))
+	TrailCompact();
+	if (cls.size() == 1 && m_NewExternalVarsAddUserCls.size() == 1 && !m_Trail.empty() && GetAssignedDecLevelVar(m_Trail[0]) == 0 && (!IsAssigned(cls[0]) || GetAssignedDecLevel(cls[0]) != 0))
 	{
-		// Exchange cls[0] by m_TrailStart's satisfied literal
+		// Exchange cls[0] by the trail start's satisfied literal
 
-		const TULit iSatLit = GetAssignedLitForVar(m_TrailStart);
+		const TULit iSatLit = GetAssignedLitForVar(m_Trail[0]);
 		const TLit eSatVar = m_NewExternalVarsAddUserCls[0];
 
 		const auto eSatLitIt = find_if(c.begin(), c.end(), [&](TLit l) { return ExternalLit2ExternalVar(l) == eSatVar; });
@@ -609,7 +648,9 @@ void CTopi<TLit, TUInd, Compress>::AddUserClause(const span<TLit> c)
 			// If we've just assigned the variable globally and the variable is new,
 			// there is no need to run Simplify, since it doesn't satisfy or appear falsified in any existing clauses, and
 			// this very function will make sure that any future clauses satisfied by it are skipped and any falsified appearances are skipped too
-			if (GetVar(cls[0]) == m_LastExistingVar && m_LastExistingVar != lastExistingVarStart && m_LastGloballySatisfiedLitAfterSimplify == m_VarInfo[GetVar(cls[0])].m_TrailPrev)
+			TrailCompact();
+			const TUV trailPos = m_VarInfo[GetVar(cls[0])].m_TrailPos;
+			if (GetVar(cls[0]) == m_LastExistingVar && m_LastExistingVar != lastExistingVarStart && m_LastGloballySatisfiedLitAfterSimplify == (trailPos == 0 ? BadUVar : m_Trail[trailPos - 1]))
 			{
 				m_LastGloballySatisfiedLitAfterSimplify = m_LastExistingVar;
 			}
@@ -890,6 +931,7 @@ void CTopi<TLit, TUInd, Compress>::HandleAssumptions(const span<TLit> userAssump
 	}
 
 	// Find the first decision level, whose decision variable doesn't appear on the list of assumptions
+	TrailCompact();
 	TUV btLevel = 0;
 	for (TUV dl = 1; dl <= m_DecLevel; ++dl, ++btLevel)
 	{
@@ -1091,6 +1133,11 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 				FixPolarityInternal(GetAssignedLitForVar(v));
 			}
 		}
+
+		if (!m_BveElimExtVars.empty())
+		{
+			BveExtendModel();
+		}
 	});
 
 	auto SetStatusLocalTimeout = [&]() { SetStatus(TToporStatus::STATUS_UNDECIDED, (string)(toInSecIsCpuTime.second ? "CPU" : "Wall") + " timeout of " + to_string(toInSecIsCpuTime.first) + " for the current Solve invocation reached"); };
@@ -1113,6 +1160,13 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 		SetStatusGlobalTimeout();
 	}
 
+	if (BveIsAnyEliminated(userAssumps))
+	{
+		// An assumption over an eliminated variable: bring back the eliminated variables
+		BveRestoreAll();
+		if (unlikely(IsUnrecoverable())) return trv = UnrecStatusToRetVal();
+	}
+
 	// Make sure to create an internal variable for any new variables amongst the assumptions (may increase m_Stat.m_MaxUserVar)
 	for (const TLit userLit : userAssumps)
 	{
@@ -1130,6 +1184,7 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 	RestartInit();
 	DecisionInit();
 	BacktrackingInit();
+	BCPInit();
 	
 	if (unlikely(IsUnrecoverable())) return trv = UnrecStatusToRetVal();
 	assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
@@ -1159,6 +1214,9 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 		}
 	}
 
+	BveIfRequired(userAssumps);
+	if (unlikely(IsUnrecoverable())) return trv = UnrecStatusToRetVal();
+
 	// Handling the assumptions, if any
 	HandleAssumptions(userAssumps);
 	if (m_Status != TToporStatus::STATUS_UNDECIDED)
@@ -1216,6 +1274,7 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 
 		InprocessIfRequired();
 		SimplifyIfRequired();
+		ClsDelTier2IfRequired();
 		DeleteClausesIfRequired();
 		CompressBuffersIfRequired();
 
@@ -1230,6 +1289,10 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
 		[[maybe_unused]] bool isContraditory = Assign(l, BadClsInd, BadULit, m_DecLevel);
 		assert(!isContraditory);
+		if (m_ParamTrailSaving)
+		{
+			SavedTrailReplay(l);
+		}
 		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
 
 		TContradictionInfo contradictionInfo = BCP();
@@ -1302,7 +1365,8 @@ TToporReturnVal CTopi<TLit, TUInd, Compress>::Solve(const span<TLit> userAssumps
 
 		if (m_Status == TToporStatus::STATUS_UNDECIDED && isContradictionBeforeConflictAnalysis && Restart())
 		{
-			Backtrack(m_DecLevelOfLastAssignedAssumption, false);
+			Backtrack(RestartBacktrackLevel(), false);
+			PhaseRephaseIfRequired();
 			if (M_GetNextUnitClause != nullptr)
 			{
 				const auto assignedVarsNumBefore = m_AssignedVarsNum;
@@ -1363,6 +1427,12 @@ Topor::TToporLitVal CTopi<TLit, TUInd, Compress>::GetValue(TLit l) const
 	const TULit litInternal = E2I(l);
 	assert(litInternal < GetNextLit());
 
+	if (BveIsEliminated(ExternalLit2ExternalVar(l)))
+	{
+		const TToporLitVal vVal = m_BveElimVals[ExternalLit2ExternalVar(l)];
+		return l > 0 || vVal == TToporLitVal::VAL_UNASSIGNED ? vVal : vVal == TToporLitVal::VAL_SATISFIED ? TToporLitVal::VAL_UNSATISFIED : TToporLitVal::VAL_SATISFIED;
+	}
+
 	// litInternal can be BadULit if the external variable doesn't appear on any clauses
 	return litInternal == BadULit ? TToporLitVal::VAL_DONT_CARE : !IsAssigned(litInternal) ? TToporLitVal::VAL_UNASSIGNED : IsFalsified(litInternal) ? TToporLitVal::VAL_UNSATISFIED : TToporLitVal::VAL_SATISFIED;
 }
@@ -1546,6 +1616,7 @@ void CTopi<TLit, TUInd, Compress>::SetMultipliers()
 	m_Watches.SetMultiplier(m_ParamMultVars);
 	m_HandleNewUserCls.SetMultiplier(m_ParamMultVars);
 	m_VsidsHeap.set_multiplier(m_ParamMultVars);
+	m_Vmtf.set_multiplier(m_ParamMultVars);
 	m_W.SetMultiplier(m_ParamMultWatches);
 }
 
@@ -1587,14 +1658,15 @@ template <typename TLit, typename TUInd, bool Compress>
 double CTopi<TLit, TUInd, Compress>::CalcMaxDecLevelScore(TUV dl) const
 {
 	double bestScore = 0;
-	for (TUVar v = dl == 0 ? m_TrailStart : GetDecVar(dl); v != BadUVar && GetAssignedDecLevelVar(v) == dl; v = m_VarInfo[v].m_TrailNext)
+	TrailForEachVarAtDecLevel(dl, [&](TUVar v)
 	{
 		const double currScore = m_VsidsHeap.get_var_score(v);
 		if (currScore > bestScore)
 		{
 			bestScore = currScore;
 		}
-	}
+		return true;
+	});
 	return bestScore;
 }
 
@@ -1602,14 +1674,15 @@ template <typename TLit, typename TUInd, bool Compress>
 double CTopi<TLit, TUInd, Compress>::CalcMinDecLevelScore(TUV dl) const
 {
 	double bestScore = numeric_limits<double>::max();
-	for (TUVar v = dl == 0 ? m_TrailStart : GetDecVar(dl); v != BadUVar && GetAssignedDecLevelVar(v) == dl; v = m_VarInfo[v].m_TrailNext)
+	TrailForEachVarAtDecLevel(dl, [&](TUVar v)
 	{
 		const double currScore = m_VsidsHeap.get_var_score(v);
 		if (currScore < bestScore)
 		{
 			bestScore = currScore;
 		}
-	}
+		return true;
+	});
 	return bestScore;
 }
 
@@ -1634,13 +1707,17 @@ string Topor::CTopi<TLit, TUInd, Compress>::GetMemoryLayout() const
 	name2Mb["m_B"] = m_B.memMb();	
 	name2Mb["m_W"] = m_W.memMb();
 	name2Mb["m_Watches"] = m_Watches.memMb();
-	name2Mb["m_TrailLastVarPerDecLevel"] = m_TrailLastVarPerDecLevel.memMb();
+	name2Mb["m_Trail"] = m_Trail.memMb();
+	name2Mb["m_TrailDecLevelStart"] = m_TrailDecLevelStart.memMb();
+	name2Mb["m_TrailCompactBuffer"] = m_TrailCompactBuffer.memMb();
 	name2Mb["m_BestScorePerDecLevel"] = m_BestScorePerDecLevel.memMb();
 	name2Mb["m_AssignmentInfo"] = m_AssignmentInfo.memMb();
 	name2Mb["m_VarInfo"] = m_VarInfo.memMb();
 	name2Mb["m_PolarityInfo"] = m_PolarityInfo.memMb();
+	name2Mb["m_PhaseSavedInfo"] = m_PhaseSavedInfo.memMb();
 	name2Mb["m_Assumps"] = m_Assumps.memMb();
 	name2Mb["m_HugeCounterPerDecLevel"] = m_HugeCounterPerDecLevel.memMb();
+	name2Mb["m_HugeCounterDecLevelsInCls"] = m_HugeCounterDecLevelsInCls.memMb();
 	name2Mb["m_DecLevelsLastAppearenceCounter"] = m_DecLevelsLastAppearenceCounter.memMb();
 	name2Mb["m_CurrClsCounters"] = m_CurrClsCounters.memMb();
 	name2Mb["m_RstNumericLocalConfsSinceRestartAtDecLevelCreation"] = m_RstNumericLocalConfsSinceRestartAtDecLevelCreation.memMb();
@@ -1657,6 +1734,14 @@ string Topor::CTopi<TLit, TUInd, Compress>::GetMemoryLayout() const
 	name2Mb["m_UserCls"] = m_UserCls.memMb();
 
 	name2Mb["m_VsidsHeap"] = m_VsidsHeap.memMb();
+	name2Mb["m_Vmtf"] = m_Vmtf.memMb();
+	name2Mb["m_LrbInfo"] = m_LrbInfo.memMb();
+	name2Mb["m_SavedTrail"] = m_SavedTrail.memMb();
+	name2Mb["m_RecentLearnts"] = m_RecentLearnts.memMb();
+	name2Mb["m_BveStack"] = m_BveStack.memMb();
+	name2Mb["m_BveElimExtVars"] = m_BveElimExtVars.memMb();
+	name2Mb["m_BveElimVals"] = m_BveElimVals.memMb();
+	name2Mb["m_FrozenExtVars"] = m_FrozenExtVars.memMb();
 	name2Mb["m_TmpClss"] = accumulate(m_TmpClss.begin(), m_TmpClss.end(), (size_t)0, [&](size_t sum, auto& it)
 	{
 		return sum + it.memMb();
@@ -1696,5 +1781,5 @@ template class Topor::CTopi<int32_t, uint64_t, true>;
 * Future
 */
 
-// #topor: conflict clause analysis: 1) vivification: see Kissat paper; 2) replace glue with 2glue?
+// #topor: conflict clause analysis: replace glue with 2glue?
 
@@ -132,6 +132,13 @@ namespace Topor
 		// Clear any polarity information of the variable v, provided by the user (so, the default solver's heuristic will be used to determine polarity)
 		// DUMPS
 		void ClearUserPolarityInfo(TLit vExternal);		
+		// Freeze the variable |l|: bounded variable elimination won't eliminate it, until it's melted as many times as it was frozen
+		// Freezing an already eliminated variable brings back all the eliminated variables
+		// DUMPS
+		void Freeze(TLit lExternal);
+		// Melt (unfreeze) the variable |l|
+		// DUMPS
+		void Melt(TLit lExternal);
 		// Backtrack to the end of decLevel; the 2nd parameter is required for statistics only
 		// DUMPS
 		void Backtrack(TLit decLevel, bool isBCPBacktrack = false, bool isAPICall = false);		
@@ -151,6 +158,16 @@ namespace Topor
 		// The number of literal-entries in an index-entry
 		static constexpr size_t LitsInInd = sizeof(TUInd) / sizeof(TLit);
 
+		// Long watches are compact in the 64-bit-index non-compressed mode: a long watch holds a 32-bit clause reference, 
+		// which is the clause index divided by WLClsIndAlignment (the clauses in the buffer are aligned accordingly), 
+		// so that a long watch occupies 8 bytes rather than 12
+		static constexpr bool WLCompact = !Compress && sizeof(TUInd) > sizeof(uint32_t) && sizeof(TLit) == sizeof(uint32_t);
+		using TWLClsRef = conditional_t<WLCompact, uint32_t, TUInd>;
+		static constexpr unsigned WLClsIndShift = WLCompact ? 2 : 0;
+		static constexpr TUInd WLClsIndAlignment = (TUInd)1 << WLClsIndShift;
+		// The number of literal-entries in a clause reference of a long watch
+		static constexpr size_t LitsInWLClsRef = sizeof(TWLClsRef) / sizeof(TLit);
+
 		// The TLit type, representing the external literals, unsigned
 		// Will be used for storing internal literals, whose sign is determined by the LSB, rather than the MSB
 		using TULit = make_unsigned<TLit>::type;
@@ -209,6 +226,17 @@ namespace Topor
 		CTopiParam<bool> m_ParamOverallTimeoutIsCpu = { m_Params, "/timeout/global_is_cpu", "Is the overall global timeout (if any) for Topor lifespan CPU (or, otherwise, Wall)", false };
 		
 		// Parameters: decision
+		static constexpr uint8_t DECISION_STRAT_VSIDS = 0;
+		static constexpr uint8_t DECISION_STRAT_VMTF = 1;
+		static constexpr uint8_t DECISION_STRAT_LRB = 2;
+		CTopiParam<uint8_t> m_ParamDecisionStrategyInit = { m_Params, "/decision/strategy_init", "Decision heuristic for the initial query: 0: VSIDS; 1: VMTF; 2: LRB", DECISION_STRAT_VSIDS, 0, 2 };
+		CTopiParam<uint8_t> m_ParamDecisionStrategyN = { m_Params, "/decision/strategy_n", "Decision heuristic for the normal (non-short) incremental query: 0: VSIDS; 1: VMTF; 2: LRB", DECISION_STRAT_VSIDS, 0, 2 };
+		CTopiParam<uint8_t> m_ParamDecisionStrategyS = { m_Params, "/decision/strategy_s", "Decision heuristic for the short incremental query: 0: VSIDS; 1: VMTF; 2: LRB", DECISION_STRAT_VSIDS, 0, 2 };
+		inline bool IsLrbUsed() const { return m_ParamDecisionStrategyInit == DECISION_STRAT_LRB || m_ParamDecisionStrategyN == DECISION_STRAT_LRB || m_ParamDecisionStrategyS == DECISION_STRAT_LRB; }
+		CTopiParam<double> m_ParamLrbStepSizeInit = { m_Params, "/decision/lrb/step_size_init", "LRB: the initial step size (the learning rate) of the exponential moving average of the rewards (0.4 in Maple)", 0.4, numeric_limits<double>::epsilon(), 1.0 };
+		CTopiParam<double> m_ParamLrbStepSizeDec = { m_Params, "/decision/lrb/step_size_dec", "LRB: the step size is decreased by this value after every conflict (1e-6 in Maple)", 1e-6, 0.0, 1.0 };
+		CTopiParam<double> m_ParamLrbStepSizeMin = { m_Params, "/decision/lrb/step_size_min", "LRB: the minimal step size (0.06 in Maple)", 0.06, numeric_limits<double>::epsilon(), 1.0 };
+		CTopiParam<double> m_ParamLrbDecay = { m_Params, "/decision/lrb/decay", "LRB: the score of an unassigned variable is multiplied by this factor for every conflict it didn't participate in (0.95 in Maple)", 0.95, numeric_limits<double>::epsilon(), 1.0 };
 		CTopiParam<uint8_t> m_ParamInitPolarityStrat = { m_Params, "/decision/polarity/init_strategy", "The initial polarity for a new variable: 0: negative; 1: positive; 2: random",  {1, 1, 1, 1, 1, 2, 1, 1, 1}, 0, 2 };
 		CTopiParam<uint8_t> m_ParamPolarityStrat = { m_Params, "/decision/polarity/strategy", "How to set the polarity for a non-forced variable: 0: phase saving; 1: random", 0, 0, 1 };
 		CTopiParam<uint32_t> m_ParamPolarityFlipFactor = { m_Params, "/decision/polarity/flip_factor", "If non-0, every N's polarity selection will be flipped", 0};
@@ -234,6 +262,8 @@ namespace Topor
 		CTopiParam<bool> m_ParamVsidsInitOrder = { m_Params, "/decision/vsids/init_order", "The order of inserting into the VSIDS heap (0: bigger indices first; 1: smaller indices first)", {false, true, false, true, true, false, true, false, false} };
 		CTopiParam<bool> m_ParamVsidsInitOrderAi = { m_Params, "/decision/vsids/init_order_ai", "After initial call: the order of inserting into the VSIDS heap (0: bigger indices first; 1: smaller indices first)", {false, true, false, true, true, false, true, true, false} };
 		CTopiParam<bool> m_ParamVarActivityGlueUpdate = { m_Params, "/decision/vsids/var_activity_glue_update", "Do we increase the VSIDS score for every last-level variable, visited during a conflict, whose parent is a learnt clause with LBD score lower than that of the newly learnt clause?", {true, true, true, false, true, true, false, false, true} };
+		CTopiParam<uint8_t> m_ParamReasonSideBumpingMaxDepth = { m_Params, "/decision/reason_side_bumping/max_depth", "Reason-side bumping: after every conflict, bump the scores of the variables in the parents of the learnt clause's literals (other than the UIP), their parents etc., up to the given depth (0: disabled)", 0 };
+		CTopiParam<uint32_t> m_ParamReasonSideBumpingMaxClsSize = { m_Params, "/decision/reason_side_bumping/max_cls_size", "Reason-side bumping: applied only if the learnt clause's size is not higher than the given value", 20 };
 		CTopiParam<bool> m_ParamVarActivityUseMapleLevelBreaker = { m_Params, "/decision/vsids/var_activity_use_maple_level_breaker", "Maple (MapleLCMDistChronoBT-f2trc-s) multiplies the variable activity bumping factor by 1.5 for variables, whose dec. level is higher-than-or-equal than 2nd highest-1 and by 0.5 for other variables; use it?", {false, false, false, true, true, false, true, false, false} };
 		CTopiParam<bool> m_ParamVarActivityUseMapleLevelBreakerAi = { m_Params, "/decision/vsids/var_activity_use_maple_level_breaker_ai", "After initial call: Maple (MapleLCMDistChronoBT-f2trc-s) multiplies the variable activity bumping factor by 1.5 for variables, whose dec. level is higher-than-or-equal than 2nd highest-1 and by 0.5 for other variables; use it?", {false, false, false, true, true, false, false, false, false} };
 		CTopiParam<uint32_t> m_ParamVarActivityMapleLevelBreakerDecrease = { m_Params, "/decision/vsids/var_activity_maple_level_breaker_decrease", "If var_activity_use_maple_level_breaker is on, this number is the decrease in the 2nd highest level, so that if the variable is higher-than-or-equal, its bump is more significant", {1, 1, 1, 1, 0, 1, 1, 1, 1} };
@@ -253,6 +283,8 @@ namespace Topor
 		CTopiParam<TUV> m_ParamChronoBtIfHigherS = { m_Params, "/backtracking/chrono_bt_if_higher_s", "Short incremental query: Backtrack chronologically, if the decision level difference is higher than the parameter", {100, numeric_limits<TUV>::max(), 50, 100, 100, 50, 100, 100, 50} };
 
 		CTopiParam<uint32_t> m_ParamConflictsToPostponeChrono = { m_Params, "/backtracking/conflicts_to_postpone_chrono", "The number of conflicts to postpone considering any backtracking, but NCB", {0, 0, 0, 4000, 8000, 0, 4000, 0, 4000} };
+		CTopiParam<double> m_ParamBulkReinsertFraction = { m_Params, "/backtracking/bulk_reinsert_fraction", "Backtracking: if the number of unassigned variables is higher than the parameter times the number of variables, they are appended to the VSIDS heap without ordering, and the heap is fixed bottom-up once (1.0: never)", 0.05, 0.0, 1.0 };
+		CTopiParam<bool> m_ParamTrailSaving = { m_Params, "/backtracking/trail_saving", "Backtracking: save the trail segment removed by a (non-BCP) backtracking with its reasons, and replay the saved implications, whose reasons still hold, once the same decisions are taken again", false };
 		CTopiParam<uint8_t> m_ParamCustomBtStratInit = { m_Params, "/backtracking/custom_bt_strat_init", "Initial query: 0: no custom backtracking; 1, 2: backtrack to the level containing the variable with the best score *instead of any instances of supposed chronological backtracking*, where ties are broken based on the value -- 1: higher levels are preferred; 2: lower levels are preferred ", {2, 0, 0, 0, 1, 0, 0, 0, 0}, 0, 2 };
 		CTopiParam<uint8_t> m_ParamCustomBtStratN = { m_Params, "/backtracking/custom_bt_strat_n", "Normal (non-short) incremental query: 0: no custom backtracking; 1, 2: backtrack to the level containing the variable with the best score *instead of any instances of supposed chronological backtracking*, where ties are broken based on the value -- 1: higher levels are preferred; 2: lower levels are preferred ", {0, 0, 0, 0, 1, 0, 0, 0, 0}, 0, 2 };
 		CTopiParam<uint8_t> m_ParamCustomBtStratS = { m_Params, "/backtracking/custom_bt_strat_s", "Short incremental query: 0: no custom backtracking; 1, 2: backtrack to the level containing the variable with the best score *instead of any instances of supposed chronological backtracking*, where ties are broken based on the value -- 1: higher levels are preferred; 2: lower levels are preferred ", {2, 0, 0, 0, 1, 0, 0, 0, 0}, 0, 2 };
@@ -264,6 +296,10 @@ namespace Topor
 		CTopiParam<uint8_t> m_ParamExistingBinWLStrat = { m_Params, "/bcp/existing_bin_wl_start", "BCP: what to do about duplicate binary clauses -- 0: nothing; 1: boost their VSIDS score; 2: add another copy to the watches; 3: inprocessing (if on) to remove duplicates; 4: inprocessing (if on) to boost their VSIDS score", {1, 1, 1, 1, 2, 1, 1, 1, 1}, 0, 4 };
 		CTopiParam<double> m_ParamBinWLScoreBoostFactor = { m_Params, "/bcp/bin_wl_start_score_boost_factor", "BCP: if /bcp/existing_bin_wl_start=1 or 4, what's the factor for boosting the scores", {1., 1., 1., 1., 1., 1., 1., 0.5, 1.}, numeric_limits<double>::epsilon() };
 		CTopiParam<uint8_t> m_ParamBestContradictionStrat = { m_Params, "/bcp/best_contradiction_strat", "BCP's best contradiction strategy: 0: size; 1: glue; 2: first; 3: last", {0, 0, 0, 0, 0, 0, 0, 3, 0}, 0, 3 };
+		CTopiParam<uint8_t> m_ParamBCPPropagationOrder = { m_Params, "/bcp/propagation_order", "BCP: the order of propagating the assigned literals -- 0: depth-first (the last assigned literal first); 1: breadth-first in trail order, where the binary clauses of all the pending literals are propagated before any long clause and the literals of lower decision levels (after delayed implications) are propagated first", 0, 0, 1 };
+		inline bool IsWLInlineClsInfoParam(const string& paramName) const { return paramName == "/bcp/inline_cls_info"; }
+		CTopiParam<bool> m_ParamWLInlineClsInfo = { m_Params, "/bcp/inline_cls_info", "BCP: keep the size and the is-learnt flag of short long clauses (ternary clauses and learnt clauses of size 4) in the 2 upper bits of the clause index in the long watches, so that BCP visits them without reading the clause header (non-compressed mode only; limits the clause buffer to 2^30 entries in the 32-bit-index mode and to 2^32 entries in the 64-bit-index mode)", false };
+		CTopiParam<uint8_t> m_ParamWLCandSimd = { m_Params, "/bcp/wl_cand_simd", "BCP: the instruction set for searching for a replacement watch in long clauses (non-compressed mode only) -- 0: scalar; 1: AVX2 (if supported by the CPU); 2: AVX-512 (if supported by the CPU, otherwise AVX2, if supported)", 0, 0, 2 };
 
 		// Parameters: Add-user-clause
 		CTopiParam<uint32_t> m_ParamAddClsRemoveClssGloballySatByLitMinSize = { m_Params, "/add_user_clause/remove_clss_globally_sat_by_literal_larger_size", "Assigned literal strategy: check for literals satisfied at decision level 0 and remove globally satisfied clauses for sizes larger than this parameter", {numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), 2, numeric_limits<uint32_t>::max()} };
@@ -288,6 +324,10 @@ namespace Topor
 		CTopiParam<bool> m_ParamMinimizeClausesMinisat = { m_Params, "/conflicts/minimize_clauses", "Conflict analysis: apply deep conflict clause minimization", true };
 		CTopiParam<uint32_t> m_ParamMinimizeClausesBinMaxSize = { m_Params, "/conflicts/bin_res_max_size", "Conflict analysis: maximal size to apply binary minimization (both this condition and maximal LBD must hold; 30 in Glucose, Fiver, Maple)", {30, 30, 30, 30, 50, 30, 30, 30, 30} };
 		CTopiParam<uint32_t> m_ParamMinimizeClausesBinMaxLbd = { m_Params, "/conflicts/bin_res_max_lbd", "Conflict analysis: maximal LBD to apply binary minimization (both this condition and maximal size must hold; 6 in Glucose, Fiver, Maple)", 6 };
+		CTopiParam<uint8_t> m_ParamShrinkInit = { m_Params, "/conflicts/shrink_init", "Initial query: conflict clause shrinking (replacing all the literals of a decision level by a single dominating literal of that level, as in Kissat) -- 0: disabled; 1: through binary parents only; 2: through any parents", 0, 0, 2 };
+		CTopiParam<uint8_t> m_ParamShrinkN = { m_Params, "/conflicts/shrink_n", "Normal (non-short) incremental query: conflict clause shrinking (replacing all the literals of a decision level by a single dominating literal of that level, as in Kissat) -- 0: disabled; 1: through binary parents only; 2: through any parents", 0, 0, 2 };
+		CTopiParam<uint8_t> m_ParamShrinkS = { m_Params, "/conflicts/shrink_s", "Short incremental query: conflict clause shrinking (replacing all the literals of a decision level by a single dominating literal of that level, as in Kissat) -- 0: disabled; 1: through binary parents only; 2: through any parents", 0, 0, 2 };
+		CTopiParam<uint8_t> m_ParamEagerSubsumptionRecent = { m_Params, "/conflicts/eager_subsumption_recent", "Eager subsumption: the number of the most recent learnt clauses checked for being subsumed by every new learnt clause (as in Kissat; 0: disabled)", 0, 0, 255 };
 		CTopiParam<uint32_t> m_ParamFlippedRecordingMaxLbdToRecord = { m_Params, "/conflicts/flipped_recording_max_lbd", "Conflict analysis: record a flipped clause with LBD smaller than or equal to the value of the parameter", {numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), numeric_limits<uint32_t>::max(), 0, 40, numeric_limits<uint32_t>::max(), 0, 90, numeric_limits<uint32_t>::max()} };
 		CTopiParam<bool> m_ParamFlippedRecordDropIfSubsumed = { m_Params, "/conflicts/flipped_drop_if_subsumed", "Conflict analysis: test and drop the flipped clause, if subsumed by the main clause", true };
 		CTopiParam<uint32_t> m_ParamOnTheFlySubsumptionContradictingMinGlueToDisable = { m_Params, "/conflicts/on_the_fly_subsumption/contradicting_min_glue_to_disable", "Conflict analysis: the minimal glue (LBD) to disable on-the-fly subsumption during conflict analysis over the contradicting clause (1: apply only over initial clauses)", {8, 0, 0, 0, 0, 8, 0, 8, 0} };
@@ -302,13 +342,14 @@ namespace Topor
 		// Parameters: restart strategy
 		static constexpr uint8_t RESTART_STRAT_NUMERIC = 0;
 		static constexpr uint8_t RESTART_STRAT_LBD = 1;
-		static constexpr uint8_t RESTART_STRAT_NONE = 2;
+		static constexpr uint8_t RESTART_STRAT_MODES = 2;
+		static constexpr uint8_t RESTART_STRAT_NONE = 3;
 		// Restart strategy: initial query
-		CTopiParam<uint8_t> m_ParamRestartStrategyInit = { m_Params, "/restarts/strategy_init", "Restart strategy for the initial query: 0: numeric (arithmetic, luby or in/out); 1: LBD-average-based", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 1 };
+		CTopiParam<uint8_t> m_ParamRestartStrategyInit = { m_Params, "/restarts/strategy_init", "Restart strategy for the initial query: 0: numeric (arithmetic, luby or in/out); 1: LBD-average-based; 2: switching between focused and stable modes", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 2 };
 		// Restart strategy: normal incremental query
-		CTopiParam<uint8_t> m_ParamRestartStrategyN = { m_Params, "/restarts/strategy_n", "Restart strategy for the normal (non-short) incremental query: 0: arithmetic; 1: LBD-average-based", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 1 };
+		CTopiParam<uint8_t> m_ParamRestartStrategyN = { m_Params, "/restarts/strategy_n", "Restart strategy for the normal (non-short) incremental query: 0: arithmetic; 1: LBD-average-based; 2: switching between focused and stable modes", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 2 };
 		// Restart strategy: short incremental query
-		CTopiParam<uint8_t> m_ParamRestartStrategyS = { m_Params, "/restarts/strategy_s", "Restart strategy for the short incremental query: 0: arithmetic; 1: LBD-average-based", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 1 };
+		CTopiParam<uint8_t> m_ParamRestartStrategyS = { m_Params, "/restarts/strategy_s", "Restart strategy for the short incremental query: 0: arithmetic; 1: LBD-average-based; 2: switching between focused and stable modes", {RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_LBD, RESTART_STRAT_NUMERIC, RESTART_STRAT_NUMERIC}, 0, 2 };
 
 		CTopiParam<bool> m_ParamRestartNumericLocal = { m_Params, "/restarts/numeric/is_local", "Restarts, numeric strategies: use local restarts?", true };
 		CTopiParam<uint32_t> m_ParamRestartNumericInitConfThr = { m_Params, "/restarts/numeric/conflict_thr", "Restarts, numeric strategy: the initial value for the conflict threshold, which triggers a restart", {1000, 1000, 1000, 1000, 100, 1000, 1000, 1000, 1000}, 1 };
@@ -325,6 +366,18 @@ namespace Topor
 		CTopiParam<double> m_ParamRestartLbdBlockingAvrgMult = { m_Params, "/restarts/lbd/blocking/average_mult", "Restarts, LBD-average-based blocking strategy: the multiplier in the formula for determining whether the restart is blocked: #assignments > multiplier * assignments-average", 1.4 };
 		CTopiParam<uint32_t> m_ParamRestartLbdBlockingWinSize = { m_Params, "/restarts/lbd/blocking/win_size", "Restarts, LBD-average-based blocking strategy: window size", {5000, 5000, 5000, 5000, 5000, 10000, 5000, 5000, 5000}, 1 };
 
+		CTopiParam<bool> m_ParamRestartModesPhaseInImplications = { m_Params, "/restarts/modes/phase_in_implications", "Restarts, mode switching strategy: measure the mode phase lengths in implications (propagated assignments), rather than in conflicts", false };
+		CTopiParam<uint32_t> m_ParamRestartModesPhaseConfs = { m_Params, "/restarts/modes/phase_conflicts", "Restarts, mode switching strategy: the length of the first mode phase in conflicts (if /restarts/modes/phase_in_implications=0)", 1000, 1 };
+		CTopiParam<double> m_ParamRestartModesPhaseImplications = { m_Params, "/restarts/modes/phase_implications", "Restarts, mode switching strategy: the length of the first mode phase in implications (if /restarts/modes/phase_in_implications=1)", 2e6, 1. };
+		CTopiParam<double> m_ParamRestartModesPhaseGrowth = { m_Params, "/restarts/modes/phase_growth", "Restarts, mode switching strategy: the length of the mode phase is multiplied by this value after every stable phase", 2., 1. };
+		CTopiParam<double> m_ParamRestartModesFocusedEmaFast = { m_Params, "/restarts/modes/focused_ema_fast", "Restarts, mode switching strategy, focused mode: the smoothing factor of the fast glue EMA", 0.03, numeric_limits<double>::min(), 1. };
+		CTopiParam<double> m_ParamRestartModesFocusedEmaSlow = { m_Params, "/restarts/modes/focused_ema_slow", "Restarts, mode switching strategy, focused mode: the smoothing factor of the slow glue EMA", 1e-5, numeric_limits<double>::min(), 1. };
+		CTopiParam<double> m_ParamRestartModesFocusedMargin = { m_Params, "/restarts/modes/focused_margin", "Restarts, mode switching strategy, focused mode: restart, if fast-glue-EMA > margin * slow-glue-EMA", 1.1 };
+		CTopiParam<uint32_t> m_ParamRestartModesFocusedMinConfs = { m_Params, "/restarts/modes/focused_min_conflicts", "Restarts, mode switching strategy, focused mode: the minimal number of conflicts between restarts", 2 };
+		CTopiParam<uint32_t> m_ParamRestartModesStableLubyUnit = { m_Params, "/restarts/modes/stable_luby_unit", "Restarts, mode switching strategy, stable mode: the conflict threshold for a restart is this value times the reluctant doubling (Luby) sequence", 1024, 1 };
+		CTopiParam<bool> m_ParamRestartModesSwitchDecisionStrat = { m_Params, "/restarts/modes/switch_decision_strat", "Restarts, mode switching strategy: use VMTF in the focused mode and VSIDS in the stable mode (otherwise, /decision/strategy_* is used)", true };
+		CTopiParam<bool> m_ParamRestartReuseTrail = { m_Params, "/restarts/reuse_trail", "Restarts: reuse the trail, that is, backtrack only to the lowest decision level, whose decision variable would not have been chosen before the next decision candidate (rather than to the last assumption); once inprocessing or simplification is due, the restart backtracks to the last assumption anyway, since they only run there", false };
+
 		// Parameters: buffer multipliers
 		inline bool IsMultiplierParam(const string& paramName) const { return paramName == "/multiplier/clauses" || paramName == "/multiplier/variables" || paramName == "/multiplier/watches_if_separate"; }
 		CTopiParam<double> m_ParamMultClss = { m_Params, "/multiplier/clauses", "The multiplier for reallocating the clause buffer", CDynArray<TUV>::MultiplierDef, 1. };
@@ -360,6 +413,10 @@ namespace Topor
 		CTopiParam<TUV> m_ParamClsDelGlueNeverDelete = { m_Params, "/deletion/clause/glue_never_delete", "Clause deletion: the highest glue value blocking clause deletion", {2, 2, 2, 2, 2, 3, 2, 2, 2}, 0, (TUV)numeric_limits<uint8_t>::max() };
 		CTopiParam<TUV> m_ParamClsDelGlueClusters = { m_Params, "/deletion/clause/glue_clusters", "Clause deletion: the number of glue clusters", {11, 0, 0, 0, 0, 11, 0, 8, 0}, 0, (TUV)numeric_limits<uint8_t>::max() };
 		CTopiParam<TUV> m_ParamClsDelGlueMaxCluster = { m_Params, "/deletion/clause/glue_max_lex_cluster", "Clause deletion: the highest glue which makes the clause belong to a glue-cluster", {16, 0, 0, 0, 0, 16, 0, 16, 3}, 0, (TUV)numeric_limits<uint8_t>::max() };
+		CTopiParam<bool> m_ParamClsDelTiers = { m_Params, "/deletion/clause/tiers", "Clause deletion: three-tier learnt clause management -- the core clauses (glue <= /deletion/clause/tier1_glue) are never deleted, the tier-2 clauses (glue <= /deletion/clause/tier2_glue) are kept while used, and the rest (local) are deleted by activity", false };
+		CTopiParam<TUV> m_ParamClsDelTier1Glue = { m_Params, "/deletion/clause/tier1_glue", "Clause deletion, tiers: the highest glue of a core clause", 2, 0, (TUV)numeric_limits<uint8_t>::max() };
+		CTopiParam<TUV> m_ParamClsDelTier2Glue = { m_Params, "/deletion/clause/tier2_glue", "Clause deletion, tiers: the highest glue of a tier-2 clause", 6, 0, (TUV)numeric_limits<uint8_t>::max() };
+		CTopiParam<uint32_t> m_ParamClsDelTier2Interval = { m_Params, "/deletion/clause/tier2_interval", "Clause deletion, tiers: the number of conflicts between the tier-2 reductions, each of which demotes the tier-2 clauses unused since the previous one (so that they can be deleted by activity)", 10000, 1 };
 
 		// Parameters: phase saving
 		CTopiParam<bool> m_ParamPhaseMngForceSolution = { m_Params, "/phase/force_solution", "Phase management: always force (the polarities of) the latest solution?", {false, false, false, false, false, false, true, false, false} };
@@ -368,6 +425,8 @@ namespace Topor
 		CTopiParam<double> m_ParamPhaseMngUnforceRestartsFractionN = { m_Params, "/phase/unforce_restarts_fraction_n", "Phase management for the normal (non-short) incremental query: don't force the polarities for the provided fraction of restarts", 0., 0., 1. };
 		CTopiParam<double> m_ParamPhaseMngUnforceRestartsFractionS = { m_Params, "/phase/unforce_restarts_fraction_s", "Phase management for the short incremental query: don't force the polarities for the provided fraction of restarts", 0., 0., 1. };
 		CTopiParam<uint8_t> m_ParamPhaseMngStartInvStrat = { m_Params, "/phase/start_inv_strat", "Phase management: startegy to start an invocation with; relevant when 0 < /phase/unforce_restarts_fraction < 1: 0: start with force; 1: start with unforce; 2: start with rand", 0, 0, 2 };
+		CTopiParam<uint8_t> m_ParamPhaseTarget = { m_Params, "/phase/target", "Phase management: use the target phases (the saved phases of the longest conflict-free trail since the last rephasing or mode switch) for non-forced decisions: 0: never; 1: in the stable mode of /restarts/strategy_*=2; 2: always", 0, 0, 2 };
+		CTopiParam<uint32_t> m_ParamPhaseRephaseInterval = { m_Params, "/phase/rephase_interval", "Phase management: if non-0, rephase at the first restart after every N*i conflicts for the i'th rephasing (cycling through the original, best, inverted, best, random, best phases)", 0 };
 		CTopiParam<bool> m_ParamPhaseBoostFlippedForced = { m_Params, "/phase/boost_flipped_forced", "Phase management: boost the scores of forced variables, flipped by BCP?", false };
 		CTopiParam<uint8_t> m_ParamUpdateParamsWhenVarFixed = { m_Params, "/phase/update_params_when_var_fixed", "Phase management: update the parameters to pre-defined values, when fixed-only-once (1) or fixed-forever (2) or either (3)", {0, 0, 0, 0, 0, 0, 0, 0, 3}, 0, 3 };
 
@@ -376,6 +435,28 @@ namespace Topor
 		CTopiParam<bool> m_ParamIngInvokeEveryQueryAfterInitPostpone = { m_Params, "/inprocessing/invoke_every_query_after_init_postpone", "Inprocessing: invoke right after every query after /inprocessing/postpone_first_inv_conflicts conflicts", true };
 		CTopiParam<uint32_t> m_ParamIngPostponeFirstInvConflicts = { m_Params, "/inprocessing/postpone_first_inv_conflicts", "Inprocessing: conflicts to postpone the very first inprocessing invocation", 0 };
 		CTopiParam<uint32_t> m_ParamIngConflictsBeforeNextInvocation = { m_Params, "/inprocessing/conflicts_before_next", "Inprocessing: conflicts before the next invocation", numeric_limits<uint32_t>::max() };
+		CTopiParam<bool> m_ParamIngVivify = { m_Params, "/inprocessing/vivify", "Inprocessing: vivify the learnt clauses (when no assumptions are assigned) by assigning the negations of their literals one by one and propagating", false };
+		CTopiParam<TUV> m_ParamIngVivifyMaxGlue = { m_Params, "/inprocessing/vivify_max_glue", "Inprocessing, vivification: only the learnt clauses of up to this glue are vivified (in the ascending order of glue, then descending order of activity)", 6, 1 };
+		CTopiParam<double> m_ParamIngVivifyEffort = { m_Params, "/inprocessing/vivify_effort", "Inprocessing, vivification: the budget in implications, relative to the number of implications since the previous vivification (scaled by the success of the previous vivifications)", 0.1, 0.0, numeric_limits<double>::max() };
+		CTopiParam<uint32_t> m_ParamIngVivifyMinEffort = { m_Params, "/inprocessing/vivify_min_effort", "Inprocessing, vivification: the minimal budget in implications", 100000 };
+		CTopiParam<bool> m_ParamIngProbe = { m_Params, "/inprocessing/probe", "Inprocessing: probe the roots of the binary implication graph (when no assumptions are assigned) to turn the failed literals into units, and substitute the equivalent literals, found as the strongly connected components of the binary implication graph", false };
+		CTopiParam<bool> m_ParamIngProbeEquivalences = { m_Params, "/inprocessing/probe_equivalences", "Inprocessing, probing: substitute the equivalent literals (skipped, if the internal literals are exposed to the outside world: DRAT, callbacks, parallel solving, debug model verification)", true };
+		CTopiParam<double> m_ParamIngProbeEffort = { m_Params, "/inprocessing/probe_effort", "Inprocessing, probing: the budget in implications, relative to the number of implications since the previous probing (scaled by the success of the previous probings)", 0.05, 0.0, numeric_limits<double>::max() };
+		CTopiParam<uint32_t> m_ParamIngProbeMinEffort = { m_Params, "/inprocessing/probe_min_effort", "Inprocessing, probing: the minimal budget in implications", 100000 };
+		CTopiParam<bool> m_ParamIngSubsume = { m_Params, "/inprocessing/subsume", "Inprocessing: forward subsumption and self-subsuming resolution (strengthening) of the long clauses, both irredundant and learnt (when no assumptions are assigned)", false };
+		CTopiParam<double> m_ParamIngSubsumeEffort = { m_Params, "/inprocessing/subsume_effort", "Inprocessing, subsumption: the budget in steps (visited occurrences and literals), relative to the number of implications since the previous subsumption (scaled by the success of the previous subsumptions)", 0.5, 0.0, numeric_limits<double>::max() };
+		CTopiParam<uint32_t> m_ParamIngSubsumeMinEffort = { m_Params, "/inprocessing/subsume_min_effort", "Inprocessing, subsumption: the minimal budget in steps", 1000000 };
+		CTopiParam<double> m_ParamIngEffortSuccessThr = { m_Params, "/inprocessing/effort_success_thr", "Inprocessing scheduler: a technique is successful, if it removes at least this number of clauses and literals per million implications (ticks) it spends; the effort of a successful technique is scaled up, otherwise down", 100., 0.0, numeric_limits<double>::max() };
+		CTopiParam<double> m_ParamIngEffortScaleFactor = { m_Params, "/inprocessing/effort_scale_factor", "Inprocessing scheduler: the factor to multiply (divide) the effort of a successful (unsuccessful) technique by", 2., 1., numeric_limits<double>::max() };
+		CTopiParam<double> m_ParamIngEffortScaleMax = { m_Params, "/inprocessing/effort_scale_max", "Inprocessing scheduler: the maximal scale of the effort of a technique", 16., 1., numeric_limits<double>::max() };
+		CTopiParam<double> m_ParamIngEffortScaleMin = { m_Params, "/inprocessing/effort_scale_min", "Inprocessing scheduler: the minimal scale of the effort of a technique", 1. / 16., 0., 1. };
+
+		// Parameters: preprocessing
+		CTopiParam<uint8_t> m_ParamBve = { m_Params, "/preprocessing/bve", "Preprocessing: bounded variable elimination -- 0: off; 1: before the initial query only; 2: before every query, if clauses were added since the previous elimination (the variables, frozen by the user, and the assumptions are never eliminated)", 0, 0, 2 };
+		CTopiParam<uint32_t> m_ParamBveMaxOccurrences = { m_Params, "/preprocessing/bve_max_occurrences", "Preprocessing, bounded variable elimination: a variable is eliminated only if each one of its literals appears in at most this number of clauses", 16, 1 };
+		CTopiParam<uint32_t> m_ParamBveClauseBound = { m_Params, "/preprocessing/bve_clause_bound", "Preprocessing, bounded variable elimination: a variable is eliminated only if the number of the resolvents exceeds the number of the removed clauses by at most this number", 0 };
+		CTopiParam<uint32_t> m_ParamBveMaxResolventSize = { m_Params, "/preprocessing/bve_max_resolvent_size", "Preprocessing, bounded variable elimination: a variable is eliminated only if none of its resolvents is longer than this number", 20, 1 };
+		CTopiParam<uint32_t> m_ParamBveMaxSteps = { m_Params, "/preprocessing/bve_max_steps", "Preprocessing, bounded variable elimination: the budget in literal visits per elimination", 10000000 };
 		
 
 		void ReadAnyParamsFromFile();
@@ -1112,6 +1193,17 @@ protected:
 		CDynArray<TULit> m_B = Compress ? 1 : InitEntriesInB;
 		TUInd m_BNext = Compress ? 1 : LitsInPage;
 		TUInd m_BWasted = 0;
+		// The number of padding entries, which keep the clauses aligned in the buffer, if the long watches are compact (see WLCompact)
+		// A padding is a deleted chunk, but it isn't counted in m_BWasted, since compressing the buffer doesn't get rid of it
+		TUInd m_BPadding = 0;
+		inline TUInd BAlignmentPadding(TUInd bInd) const { return (TUInd)(0 - bInd) & (WLClsIndAlignment - 1); }
+		inline void BAddPadding(TUInd bInd, TUInd padding)
+		{
+			assert(padding != 0 && padding < WLClsIndAlignment);
+			m_B[bInd] = (TULit)(padding - 1);
+			assert(ClsChunkDeleted(bInd) && ClsEnd(bInd) == bInd + padding);
+			m_BPadding += padding;
+		}
 
 		constexpr static TUV ClsIsLearntBits = 1;
 		constexpr static TUV ClsLShiftToIsLearntOn = numeric_limits<TUV>::digits - 1;
@@ -1449,6 +1541,21 @@ protected:
 			}
 		}
 
+		// Three-tier learnt clause management steals the least significant bit of the activity's mantissa to mark the clause as used
+		inline bool ClsGetUsed(TUInd clsInd) { return bit_cast<uint32_t>(ClsGetActivity(clsInd)) & 1; }
+		inline float ClsActivityWithUsed(float a, bool isUsed) const { return bit_cast<float>((bit_cast<uint32_t>(a) & ~(uint32_t)1) | (uint32_t)isUsed); }
+		inline void ClsSetUsed(TUInd clsInd, bool isUsed) { ClsSetActivity(clsInd, ClsActivityWithUsed(ClsGetActivity(clsInd), isUsed)); }
+		// The core clauses are never deleted, while the tier-2 clauses are kept as long as they're used
+		inline bool ClsDelIsKeptByTier(TUInd clsInd)
+		{
+			if (!m_ParamClsDelTiers)
+			{
+				return false;
+			}
+			const TUV glue = ClsGetGlue(clsInd);
+			return glue <= m_ParamClsDelTier1Glue || (glue <= m_ParamClsDelTier2Glue && ClsGetUsed(clsInd));
+		}
+
 		template <bool TCompress = Compress>
 		inline void ClsSetSkipdel(TUInd clsInd, bool skipDel)
 		{
@@ -1604,6 +1711,10 @@ protected:
 				Update();
 			}				
 
+			// The header is not read, since the literals' offset and the size are provided by the caller
+			CStandardCls(CDynArray<TULit>& b, bool& anyOversized, TUInd clsInd, TUV litsStartOffset, TUV clsSize) : CMutableClsBase(b, anyOversized, clsInd),
+				m_Span(b.get_span_cap(clsInd + litsStartOffset, clsSize)) {}
+
 			using TIterator = TSpanTULit::iterator;
 
 			inline TIterator begin()
@@ -1763,6 +1874,8 @@ protected:
 		template <bool TCompress = Compress>
 		void DeleteCls(TUInd clsInd, array<TULit, 2>* newBinCls = nullptr)
 		{
+			SavedTrailInvalidate();
+			RecentLearntsForget(clsInd);
 			auto cls = Cls(clsInd);
 
 			if constexpr (!TCompress)
@@ -1847,6 +1960,7 @@ protected:
 		template <bool TCompress = Compress>
 		void DeleteLitFromCls(TUInd& clsInd, TULit l)
 		{
+			RecentLearntsForget(clsInd);
 			auto cls = Cls(clsInd);
 			assert(ClsGetSize(clsInd) > 3);
 
@@ -1891,6 +2005,7 @@ protected:
 				}
 				// Resizing our clause	
 				ClsSetSize(clsInd, (TUV)cls.size() - 1);
+				WLRefreshInlinedClsInfo(clsInd);
 				RecordDeletedLitsFromCls(1);
 			}
 			else
@@ -1938,7 +2053,7 @@ protected:
 
 			inline bool IsEmpty() const { assert(m_WBInd != 0 || (m_AllocatedEntries == 0 && m_BinaryWatches == 0 && m_LongWatches == 0)); return m_AllocatedEntries == 0; }
 
-			static constexpr TUInd BinsInLong = 1 + (TUInd)LitsInInd;
+			static constexpr TUInd BinsInLong = 1 + (TUInd)LitsInWLClsRef;
 			static constexpr TUInd BinsInLongBitCeil = bit_ceil(BinsInLong);
 			static constexpr size_t BinsInLongBytes = sizeof(TULit) * TWatchInfo::BinsInLong;
 			static constexpr TUInd MaxWatchInfoAlloc = rotr((TUInd)1, 1);
@@ -1954,9 +2069,9 @@ protected:
 		// long watches (literal, clause-buffer-index), followed by binary watches (1 literal each)
 		// Long watched come first, since, otherwise, there could have been a hole, when adding a binary watch
 
-		// 1: long-watch {1 + LitsInInd entries} [literal, clause-buffer-index]
+		// 1: long-watch {1 + LitsInWLClsRef entries} [literal, clause-reference]
 		// ................
-		// m_Watches[l].m_LongWatches: long-watch {1 + LitsInInd entries} [literal, clause-buffer-index]
+		// m_Watches[l].m_LongWatches: long-watch {1 + LitsInWLClsRef entries} [literal, clause-reference]
 		// 1: binary-watch {1 entry} [literal] 
 		// ................
 		// m_Watches[l].m_BinaryWatches: binary-watch {1 entry} [literal]
@@ -2010,7 +2125,86 @@ protected:
 		//			(a) Increasing the odds that we won't need to copy over the watches during the instance creation process
 		//			(b) Being cache-friendly
 		bool WLIsLitBetter(TULit lCand, TULit lOther) const;
-		inline TUInd LastWLEntry(TULit l) { return m_Watches[l].m_WBInd + m_Watches[l].GetLongEntries() - LitsInInd; }
+		inline TUInd LastWLEntry(TULit l) { return m_Watches[l].m_WBInd + m_Watches[l].GetLongEntries() - LitsInWLClsRef; }
+
+		// Inlined clause information in long watches (non-compressed mode only, enabled by /bcp/inline_cls_info): 
+		// the clause reference stored in a long watch holds a code in its upper WLInlineBits bits.
+		// Code 0 stands for no information; otherwise, the code provides the size and the is-learnt flag of the clause, 
+		// which suffices to build the clause's span without reading the clause header
+		static constexpr TUV WLInlineBits = 2;
+		static constexpr TUV WLInlineShift = (TUV)numeric_limits<TWLClsRef>::digits - WLInlineBits;
+		static constexpr TWLClsRef WLInlineClsIndMask = ((TWLClsRef)1 << WLInlineShift) - (TWLClsRef)1;
+		static constexpr array<TUV, (size_t)1 << WLInlineBits> WLInlineSize = { 0, 3, 3, 4 };
+		static constexpr array<bool, (size_t)1 << WLInlineBits> WLInlineIsLearnt = { false, false, true, true };
+		// The mask for extracting the (possibly aligned) clause index out of the clause reference: all-ones, if the information is not inlined
+		TWLClsRef m_WLClsIndMask = numeric_limits<TWLClsRef>::max();
+		
+		inline TUInd WLClsInd(TWLClsRef clsRef) const { return (TUInd)(clsRef & m_WLClsIndMask) << WLClsIndShift; }
+		
+		inline TWLClsRef WLClsRef(TUInd clsInd, TUV clsSize, bool isLearnt) const
+		{
+			assert((clsInd & (WLClsIndAlignment - 1)) == 0);
+			assert(((clsInd >> WLClsIndShift) & ~(TUInd)m_WLClsIndMask) == 0);
+			if constexpr (Compress)
+			{
+				return clsInd;
+			}
+			else
+			{
+				const TWLClsRef alignedClsInd = (TWLClsRef)(clsInd >> WLClsIndShift);
+				const TWLClsRef code = clsSize == 3 ? (TWLClsRef)1 + (TWLClsRef)isLearnt : clsSize == 4 && isLearnt ? (TWLClsRef)3 : (TWLClsRef)0;
+				return m_WLClsIndMask == numeric_limits<TWLClsRef>::max() ? alignedClsInd : alignedClsInd | (code << WLInlineShift);
+			}
+		}
+		
+		inline TWLClsRef WLClsRef(TUInd clsInd)
+		{
+			if constexpr (Compress)
+			{
+				return clsInd;
+			}
+			else
+			{
+				return m_WLClsIndMask == numeric_limits<TWLClsRef>::max() || clsInd == BadClsInd ? (TWLClsRef)(clsInd >> WLClsIndShift) : WLClsRef(clsInd, ClsGetSize(clsInd), ClsGetIsLearnt(clsInd));
+			}
+		}
+
+		// The highest clause buffer index, which can be referred to by a long watch
+		inline TUInd WLMaxClsInd() const { return (TUInd)m_WLClsIndMask << WLClsIndShift; }
+
+		// The clause of a long watch, given its clause reference
+		inline CCls WLCls(TWLClsRef clsRef)
+		{
+			if constexpr (Standard)
+			{
+				const TWLClsRef code = (clsRef & ~m_WLClsIndMask) >> WLInlineShift;
+				const TUInd clsInd = WLClsInd(clsRef);
+				if (code == 0)
+				{
+					return Cls(clsInd);
+				}
+				assert(ClsGetSize(clsInd) == WLInlineSize[code] && ClsGetIsLearnt(clsInd) == WLInlineIsLearnt[code]);
+				return CStandardCls(m_B, m_AnyOversized, clsInd, EClsLitsStartOffset(WLInlineIsLearnt[code], false), WLInlineSize[code]);
+			}
+			else
+			{
+				return Cls(clsRef);
+			}
+		}
+
+		// Refresh the inlined information in the two watches of a clause, whose size has just been changed
+		inline void WLRefreshInlinedClsInfo(TUInd clsInd)
+		{
+			if (m_WLClsIndMask != numeric_limits<TUInd>::max())
+			{
+				const auto cls = ConstClsSpan(clsInd, 2);
+				WLReplaceInd(cls[0], clsInd, clsInd);
+				WLReplaceInd(cls[1], clsInd, clsInd);
+			}
+		}
+
+		// Apply the current value of /bcp/inline_cls_info, re-encoding the existing long watches
+		void WLInlineClsInfoInit();
 
 
 		/*
@@ -2019,19 +2213,73 @@ protected:
 		
 		// The current decision level
 		TUV m_DecLevel = 0;
-		// The last variable on the trail per decision level
-		CDynArray<TUVar> m_TrailLastVarPerDecLevel;
-		// Get the decision variable of the given decision level
-		inline TUVar GetDecVar(TUV decLevel) const
+		// The trail: the assigned variables, ordered by decision level and, within each decision level, by the order of assignment
+		// The trail is a contiguous array, whose prefix m_Trail[0, m_TrailSortedEnd) is ordered. 
+		// The assignments below the highest decision level of the prefix (which happen because of chronological backtracking and delayed implications)
+		// are appended to the suffix, and unassigning a variable anywhere, but at the end of the trail, leaves a hole (BadUVar) in its place.
+		// TrailCompact orders the suffix into the prefix and removes the holes; it's applied at the end of BCP and before any ordered traversal of the trail
+		CVector<TUVar> m_Trail;
+		// The start offset of every decision level in the ordered prefix of the trail up to m_TrailTopDecLevel
+		CDynArray<TUV> m_TrailDecLevelStart;
+		// The end of the ordered prefix of the trail
+		TUV m_TrailSortedEnd = 0;
+		// The highest decision level in the ordered prefix of the trail (any higher level is empty)
+		TUV m_TrailTopDecLevel = 0;
+		// The lowest decision level, which has either holes or out-of-order assignments (numeric_limits<TUV>::max(), if the trail is compact)
+		TUV m_TrailDirtyDecLevel = numeric_limits<TUV>::max();
+		// A buffer for TrailCompact
+		CDynArray<TUVar> m_TrailCompactBuffer;
+		inline bool TrailIsCompact() const { return m_TrailDirtyDecLevel == numeric_limits<TUV>::max(); }
+		void TrailCompact();
+		// The boundaries of the given decision level in the ordered prefix of the trail
+		inline TUV TrailDecLevelStart(TUV decLevel) const { return decLevel <= m_TrailTopDecLevel ? m_TrailDecLevelStart[decLevel] : m_TrailSortedEnd; }
+		inline TUV TrailDecLevelEnd(TUV decLevel) const { return decLevel < m_TrailTopDecLevel ? m_TrailDecLevelStart[decLevel + 1] : m_TrailSortedEnd; }
+		// The last variable on the trail (the trail must be compact)
+		inline TUVar TrailEndVar() const { assert(TrailIsCompact()); return m_Trail.empty() ? BadUVar : m_Trail[m_Trail.size() - 1]; }
+		// The last variable on the trail at the given decision level or BadUVar, if the level is empty (the trail must be compact)
+		inline TUVar TrailLastVarAtDecLevel(TUV decLevel) const 
 		{ 
-			assert(decLevel > 0 && decLevel <= m_DecLevel); 
-			// Skip any collapsed decision levels
-			auto prevDlLastVar = m_TrailLastVarPerDecLevel[decLevel - 1];
-			while (decLevel > 0 && (prevDlLastVar = m_TrailLastVarPerDecLevel[decLevel - 1]) == BadUVar)
+			assert(TrailIsCompact()); 
+			return TrailDecLevelStart(decLevel) == TrailDecLevelEnd(decLevel) ? BadUVar : m_Trail[TrailDecLevelEnd(decLevel) - 1];
+		}
+		// Apply func to every variable assigned at the given decision level (in the order of assignment, if the trail is compact), until func returns false
+		// Works for a trail, which isn't compact too
+		template <class TFunc>
+		inline void TrailForEachVarAtDecLevel(TUV decLevel, TFunc func) const
+		{
+			for (TUV trailPos = TrailDecLevelStart(decLevel); trailPos < TrailDecLevelEnd(decLevel); ++trailPos)
+			{
+				if (m_Trail[trailPos] != BadUVar && !func(m_Trail[trailPos]))
+				{
+					return;
+				}
+			}
+
+			if (!TrailIsCompact())
 			{
-				--decLevel;				
+				for (TUV trailPos = m_TrailSortedEnd; trailPos < (TUV)m_Trail.size(); ++trailPos)
+				{
+					if (m_Trail[trailPos] != BadUVar && GetAssignedDecLevelVar(m_Trail[trailPos]) == decLevel && !func(m_Trail[trailPos]))
+					{
+						return;
+					}
+				}
 			}
-			return prevDlLastVar == BadUVar ? m_TrailStart : m_VarInfo[prevDlLastVar].m_TrailNext;
+		}
+		inline bool TrailDecLevelIsEmpty(TUV decLevel) const
+		{
+			bool isEmpty = true;
+			TrailForEachVarAtDecLevel(decLevel, [&](TUVar) { isEmpty = false; return false; });
+			return isEmpty;
+		}
+
+		// Get the decision variable of the given decision level (the trail must be compact)
+		inline TUVar GetDecVar(TUV decLevel) const
+		{ 
+			assert(decLevel > 0 && decLevel <= m_DecLevel && TrailIsCompact()); 
+			// Any collapsed decision levels are skipped
+			const TUV trailPos = TrailDecLevelStart(decLevel);
+			return trailPos < (TUV)m_Trail.size() ? m_Trail[trailPos] : BadUVar;
 		}
 
 		inline bool DecLevelIsCollapsed(TUV decLevel) const
@@ -2042,22 +2290,24 @@ protected:
 			}
 			assert(decLevel <= m_DecLevel);
 
-			return m_TrailLastVarPerDecLevel[decLevel] == BadUVar;
+			return TrailDecLevelIsEmpty(decLevel);
 		}
 		
 		CDynArray<double> m_BestScorePerDecLevel;
 		TUV GetDecLevelWithBestScore(TUV dlLowestIncl, TUV dlHighestExcl);
 		double CalcMaxDecLevelScore(TUV dl) const;
 		double CalcMinDecLevelScore(TUV dl) const;
-		// The pointer to trail start
-		TUVar m_TrailStart = BadUVar;
-		// The pointer to trail end
-		TUVar m_TrailEnd = BadUVar;
 		// Literals to propagate
 		CVector<TULit> m_ToPropagate;
 		inline void ToPropagatePushBack(TULit l) { m_ToPropagate.push_back(l);  }
 		inline TULit ToPropagateBackAndPop() { return m_ToPropagate.pop_back(); }
-		inline void ToPropagateClear() { m_ToPropagate.clear(); }
+		inline void ToPropagateClear() { m_ToPropagate.clear(); m_ToPropagateBinHead = m_ToPropagateLongHead = 0; m_ToPropagateSortByDecLevel = false; }
+		// Breadth-first BCP (/bcp/propagation_order=1) uses m_ToPropagate as a queue in trail order with two heads:
+		// the binary watches are propagated for the literals before m_ToPropagateBinHead, and the long watches for the literals before m_ToPropagateLongHead
+		size_t m_ToPropagateBinHead = 0;
+		size_t m_ToPropagateLongHead = 0;
+		// Breadth-first BCP: re-sort the not-yet-propagated literals by their decision levels before the next propagation (set after out-of-order assignments)
+		bool m_ToPropagateSortByDecLevel = false;
 		
 		// Contradiction information (meant to be returned by BCP for conflict analysis) 
 		struct TContradictionInfo
@@ -2169,12 +2419,11 @@ protected:
 
 		struct TVarInfo
 		{
-			inline void Assign(TUInd parentClsInd, TULit otherWatch, TUV decLevel, TUVar trailPrev, TUVar trailNext)
+			inline void Assign(TUInd parentClsInd, TULit otherWatch, TUV decLevel, TUV trailPos)
 			{
 				parentClsInd == BadClsInd && otherWatch != BadULit ? m_BinOtherLit = otherWatch : m_ParentClsInd = parentClsInd;
 				m_DecLevel = decLevel;
-				m_TrailPrev = trailPrev;
-				m_TrailNext = trailNext;				
+				m_TrailPos = trailPos;
 			}
 			
 			inline bool IsDecVar() const { return m_DecLevel != 0 && m_ParentClsInd == BadUVar; }						
@@ -2193,10 +2442,8 @@ protected:
 				TUV m_DecLevel;				
 			};
 
-			// The previous variable on the trail
-			TUVar m_TrailPrev;
-			// The next variable on the trail
-			TUVar m_TrailNext;
+			// The position on the trail
+			TUV m_TrailPos;
 		};
 
 		struct TPolarityInfo
@@ -2221,14 +2468,21 @@ protected:
 		static_assert(sizeof(TPolarityInfo) == 1);
 		bool m_PolarityInfoActivated = false;
 
-		inline TUVar GetTrailPrevVar(TUVar v) const { return m_VarInfo[v].m_TrailPrev; }
-		inline TUVar GetTrailNextVar(TUVar v) const { return m_VarInfo[v].m_TrailNext; }
-
 		TUV m_AssignedVarsNum = 0;
 		CDynArray<TAssignmentInfo> m_AssignmentInfo;
+		// The vectorized FindBestWLCand gathers the assignment info in aligned 4-byte words, so the capacity must cover the whole word of the last variable
+		static constexpr size_t AssignmentInfoCap(size_t varsNum) { return (varsNum + 3) & ~(size_t)3; }
 		size_t m_PrevAiCap = 0;
 		CDynArray<TVarInfo> m_VarInfo;
 		CDynArray<TPolarityInfo> m_PolarityInfo;
+		// The target and the best phases (see the phase management); allocated only if either is used
+		struct TPhaseSavedInfo
+		{
+			uint8_t m_TargetIsNegated : 1;
+			uint8_t m_BestIsNegated : 1;
+		};
+		static_assert(sizeof(TPhaseSavedInfo) == 1);
+		CDynArray<TPhaseSavedInfo> m_PhaseSavedInfo;
 		bool m_UpdateParamsWhenVarFixedDone = false;
 		uint32_t m_NonForcedPolaritySelectionForFlip = 0;
 		inline bool IsAssignedVar(TUVar v) const
@@ -2400,9 +2654,26 @@ protected:
 		CVector<TContradictionInfo> m_Cis;
 		// Run BCP
 		TContradictionInfo BCP();
+		// The BCP loop, where the features, disabled by the current parameters, are compiled away: 
+		// Simplify: maintain the implications counter for /deletion/simplify; 
+		// ChronoBt: handle delayed implications (the kernel without it hands off to the one with it upon meeting an out-of-order trail);
+		// Fifo: breadth-first propagation (/bcp/propagation_order=1)
+		template <bool Simplify, bool ChronoBt, bool Fifo>
+		void BCPKernel();
+		// Breadth-first BCP: sort the literals, whose binary or long watches are still to be propagated, by their decision levels
+		void BCPSortToPropagateByDecLevel();
+		bool m_BCPFifo = false;
+		// The BCP loop variant for the current Solve (selected in BCPInit)
+		void (CTopi::*m_BCPKernel)() = nullptr;
+		// Handle a new contradiction discovered by BCP; returns true iff BCP should stop propagating the current literal
+		bool BCPNewContradiction(TContradictionInfo&& newCi);
 		// Backtracking during BCP
 		void BCPBacktrack(TUV decLevel, bool eraseDecLevel);
 		CCls::TIterator FindBestWLCand(CCls& cls, TUV maxDecLevel);
+		// Initialize BCP-related data before Solve
+		void BCPInit();
+		// The instruction set used by FindBestWLCand (resolved in BCPInit, given /bcp/wl_cand_simd and the CPU): 0: scalar; 1: AVX2; 2: AVX-512
+		uint8_t m_WLCandSimd = 0;
 
 		// Swap watch watchInd in the clause with newWatchIt
 		void SwapWatch(const TUInd clsInd, bool watchInd, CCls::TIterator newWatchIt);
@@ -2482,7 +2753,44 @@ protected:
 		* Decision Strategy
 		*/
 
+		// Compile with -DTOPOR_FLOAT_VAR_SCORES to halve the memory footprint of the variable scores (and the VSIDS heap) using float scores
+#ifdef TOPOR_FLOAT_VAR_SCORES
+		CVarScores<TUVar, TUV, float> m_VsidsHeap;
+#else
 		CVarScores<TUVar, TUV> m_VsidsHeap;
+#endif
+		// The VMTF queue contains all the variables at all times, but it is bumped and its cursor is maintained only when VMTF is the current decision heuristic
+		// The VSIDS heap is neither popped nor bumped while VMTF is used, so it keeps all the variables (with their scores frozen)
+		CVmtfQueue<TUVar> m_Vmtf;
+		uint8_t m_CurrDecisionStrat = DECISION_STRAT_VSIDS;
+		void DecisionStratSet(uint8_t newDecisionStrat);
+		// LRB (learning-rate-based branching, as in Maple solvers) keeps its scores in the VSIDS heap, where a variable's score is
+		// an exponential moving average of the rate of the learnt clauses it participated in while being assigned
+		// The score is updated when the variable is unassigned and is decayed lazily, when it reaches the top of the heap
+		struct TLrbInfo
+		{
+			// The conflict number at the variable's assignment
+			uint64_t m_AssignedConf;
+			// The conflict number at the variable's last score update or decay
+			uint64_t m_UpdatedConf;
+			// The number of the conflicts the variable participated in since its assignment
+			uint32_t m_Participated;
+			// The conflict number at the variable's last participation (it's counted once per conflict)
+			uint64_t m_ParticipatedConf;
+		};
+		CDynArray<TLrbInfo> m_LrbInfo;
+		double m_LrbStepSize = 0.;
+		inline void LrbOnUnassign(TUVar v)
+		{
+			auto& li = m_LrbInfo[v];
+			const uint64_t interval = m_Stat.m_Conflicts - li.m_AssignedConf;
+			if (interval > 0)
+			{
+				const double reward = (double)li.m_Participated / (double)interval;
+				m_VsidsHeap.update_score(v, (1. - m_LrbStepSize) * m_VsidsHeap.get_var_score(v) + m_LrbStepSize * reward);
+			}
+			li.m_UpdatedConf = m_Stat.m_Conflicts;
+		}
 
 		// Get the decision literal
 		TULit Decide();
@@ -2491,6 +2799,12 @@ protected:
 		inline bool IsForced(TUVar v) const { return m_PolarityInfoActivated && v < m_PolarityInfo.cap() && m_PolarityInfo[v].IsNextPolarityDetermined() && m_PhaseStage != TPhaseStage::PHASE_STAGE_DONT_FORCE; }
 		inline bool IsNotForced(TUVar v) const { return !m_PolarityInfoActivated || v >= m_PolarityInfo.cap() || !m_PolarityInfo[v].IsNextPolarityDetermined() || m_PhaseStage == TPhaseStage::PHASE_STAGE_DONT_FORCE; }
 		void UpdateScoreVar(TUVar v, double mult = 1.0);
+		// Update the score of a variable, visited by conflict analysis (unlike the other bump sources, it's LRB's participation in the conflict)
+		void UpdateScoreVarOnAnalysis(TUVar v, double mult);
+		// VMTF: bump the variables, visited by conflict analysis, in the order of their time-stamps
+		void VmtfBumpVisitedVars();
+		// Bump the scores of the variables in the parents of the learnt clause's literals (other than the UIP, which must be the first literal), up to the given depth
+		void BumpReasonSideVars(const span<TULit> cls);
 		// This function is invoked after every conflict
 		void UpdateDecisionStrategyOnNewConflict(TUV glueScoreOfLearnt, TUVar lowestGlueUpdateVar, TUVar fakeTrailEnd);
 		void DecisionInit();
@@ -2507,6 +2821,22 @@ protected:
 		*/
 		void BacktrackingInit();
 		TUV m_CurrChronoBtIfHigher = 0;
+		// Trail saving: the trail segment removed by the latest backtracking in trail order, where a decision has no reason (both m_BinOtherLit and m_ParentClsInd are bad)
+		struct TSavedImplication
+		{
+			TULit m_Lit;
+			TULit m_BinOtherLit;
+			TUInd m_ParentClsInd;
+			inline bool IsDecision() const { return m_BinOtherLit == BadULit && m_ParentClsInd == BadClsInd; }
+		};
+		CVector<TSavedImplication> m_SavedTrail;
+		// The next saved entry to be matched, which is always a decision
+		size_t m_SavedTrailNext = 0;
+		void SavedTrailSave(TUV decLevel);
+		// Replay the implications saved for the given (just assigned) decision, as long as their reasons still hold
+		void SavedTrailReplay(TULit decLit);
+		// The saved reasons mustn't refer to deleted or moved clauses
+		inline void SavedTrailInvalidate() { m_SavedTrail.clear(); m_SavedTrailNext = 0; }
 		uint8_t m_CurrCustomBtStrat = 0;
 		uint64_t m_ConfsSinceNewInv = 0;
 
@@ -2528,6 +2858,35 @@ protected:
 		// Binary minimization (there in Glucose, Fiver, Maple)
 		// Uses m_RootedVars, which must be empty before the MinimizeClause call
 		void MinimizeClauseBin(CVector<TULit>& cls);
+		// Shrinking (there in Kissat): replace all the literals of every previous decision level by that level's UIP (binaryParentsOnly: resolve over binary parents only)
+		// Uses m_RootedVars, which must be empty before the ShrinkClause call
+		void ShrinkClause(CVector<TULit>& cls, bool binaryParentsOnly);
+		inline uint8_t GetShrinkMode() const
+		{
+			return m_QueryCurr == TQueryType::QUERY_INC_NORMAL ? m_ParamShrinkN :
+				m_QueryCurr == TQueryType::QUERY_INC_SHORT ? m_ParamShrinkS : m_ParamShrinkInit;
+		}
+		// Eager subsumption: the most recent learnt clauses, organized as a cyclic buffer; BadClsInd stands for a clause, which has been deleted or modified since
+		CVector<TUInd> m_RecentLearnts;
+		size_t m_RecentLearntsNext = 0;
+		// Delete the recent learnt clauses subsumed by the new learnt clause, all of whose literals must be falsified, then remember the new clause
+		// Uses m_RootedVars, which must be empty before the EagerSubsumeRecentLearnts call
+		void EagerSubsumeRecentLearnts(const span<TULit> cls, TUInd clsInd);
+		inline void RecentLearntsForget(TUInd clsInd)
+		{
+			for (TUInd& recentClsInd : m_RecentLearnts.get_span())
+			{
+				if (recentClsInd == clsInd)
+				{
+					recentClsInd = BadClsInd;
+				}
+			}
+		}
+		inline void RecentLearntsClear()
+		{
+			m_RecentLearnts.clear();
+			m_RecentLearntsNext = 0;
+		}
 		// AllUIP clause generation, based on the ALL-UIP SAT'20 paper; returns an empty clause, if fails
 		// Returns true iff succeeded
 		bool GenerateAllUipClause(CVector<TULit>& cls);
@@ -2605,9 +2964,11 @@ protected:
 
 		uint64_t m_HugeCounterDecLevels = 0;
 		CDynArray<uint64_t> m_HugeCounterPerDecLevel;
-		// ret.first: for every decision level m_HugeCounterPerDecLevel[decLevel] - ret.first is the number of literals in cls with that decision level
-		// ret.second: all the decision levels in cls in a priority queue (top will return the greatest first)		
-		pair<uint64_t, priority_queue<TUV>> GetDecLevelsAndMarkInHugeCounter(TSpanTULit cls);
+		// ret: for every decision level m_HugeCounterPerDecLevel[decLevel] - ret is the number of literals in cls with that decision level
+		// m_HugeCounterDecLevelsInCls is filled with all the decision levels in cls, from the greatest to the lowest
+		uint64_t GetDecLevelsAndMarkInHugeCounter(TSpanTULit cls);
+		// Reused across conflicts to avoid an allocation per call
+		CVector<TUV> m_HugeCounterDecLevelsInCls;
 		TCounterType m_MarkedDecLevelsCounter = 0;
 		CDynArray<TCounterType> m_DecLevelsLastAppearenceCounter;
 		inline bool IsAssignedMarkedDecLevel(TULit l) const { return IsAssignedMarkedDecLevelVar(GetVar(l)); }
@@ -2657,6 +3018,21 @@ protected:
 		void NewDecLevel();
 		uint8_t m_CurrRestartStrat = RESTART_STRAT_NONE;
 		void RestartInit();
+		// The decision level to backtrack to at a restart
+		TUV RestartBacktrackLevel();
+		// Mode switching: focused mode restarts when the fast glue EMA exceeds the slow one; stable mode restarts by reluctant doubling
+		bool m_RstModeIsStable = false;
+		TEmaAverage m_RstModeGlueEmaFast;
+		TEmaAverage m_RstModeGlueEmaSlow;
+		double m_RstModePhaseLen = 0.;
+		// The end of the current mode phase in conflicts or implications
+		double m_RstModePhaseEnd = 0.;
+		uint64_t m_RstModeStableRestarts = 0;
+		uint64_t m_RstModeStableConfThr = 0;
+		inline uint64_t RstModePhaseCounter() const { return m_ParamRestartModesPhaseInImplications ? m_Stat.m_Implications : m_Stat.m_Conflicts; }
+		void RstModesInit();
+		void RstModeSwitch();
+		inline bool IsRstModeDecisionStrat() const { return m_CurrRestartStrat == RESTART_STRAT_MODES && m_ParamRestartModesSwitchDecisionStrat; }
 		uint64_t m_RestartsSinceInvStart = 0;
 		static double RestartLubySequence(double y, uint64_t x);
 
@@ -2672,10 +3048,15 @@ protected:
 		int64_t m_ImplicationsTillNextSimplify = 0;
 		
 		void SimplifyIfRequired();
+		// Simplification is due, once the implications budget is exhausted, if there are new globally satisfied literals (disregarding the decision level; the trail must be compact)
+		inline bool IsSimplifyDue() const { return m_ImplicationsTillNextSimplify <= 0 && TrailLastVarAtDecLevel(0) != m_LastGloballySatisfiedLitAfterSimplify; }
 		void CompressBuffersIfRequired();
 		void CompressWLs();
 		bool DebugAssertWaste();
 		void DeleteClausesIfRequired();
+		// Clear the used flags of the non-core learnt clauses every /deletion/clause/tier2_interval conflicts
+		void ClsDelTier2IfRequired();
+		uint64_t m_ClsDelTier2Next = 0;
 
 		// IMPORTANT: in compressed mode, returns the next bit in the current buffer (rather than the whole BC index, including, e.g., the 11 hash bits)
 		inline TUInd ClsEnd(TUInd clsInd) 
@@ -2753,7 +3134,8 @@ protected:
 			else
 			{
 				m_ClsLoopCurrStandardCls = m_CurrLoopIsLearntOnly ? m_FirstLearntClsInd : LitsInPage;
-				m_ClsLoopNextStandardCls = ClsEnd(m_ClsLoopCurrStandardCls);
+				// There might be no learnt clauses at all (m_FirstLearntClsInd is beyond the buffer then)
+				m_ClsLoopNextStandardCls = ClsLoopCompleted() ? BadClsInd : ClsEnd(m_ClsLoopCurrStandardCls);
 				return m_ClsLoopCurrStandardCls;
 			}
 		}
@@ -2831,6 +3213,23 @@ protected:
 			}
 		};
 		TClsDelInfo m_ClsDelInfo;
+		// A learnt clause deletion candidate: the clauses are deleted in the ascending order of the key, which packs (from the most significant bits):
+		// (1) the cluster, reversed (8 bits; 0, if there are no clusters); (2) the activity (32 bits); (3) the glue, reversed (24 bits, the higher glues are saturated)
+		struct TClsDelCandidate
+		{
+			uint64_t m_Key;
+			TUInd m_ClsInd;
+			inline bool operator<(const TClsDelCandidate& other) const { return m_Key < other.m_Key; }
+		};
+		inline uint64_t ClsDelKey(uint8_t cluster, float activity, TUV glue) const
+		{
+			static constexpr uint32_t glueBits = 24;
+			static constexpr uint32_t glueMax = (1 << glueBits) - 1;
+			// Map the float to an unsigned integer of the same order
+			const uint32_t actBits = bit_cast<uint32_t>(activity);
+			const uint32_t actOrdered = (actBits & 0x80000000) ? ~actBits : (actBits | 0x80000000);
+			return ((uint64_t)(numeric_limits<uint8_t>::max() - cluster) << 56) | ((uint64_t)actOrdered << glueBits) | (uint64_t)(glueMax - min((uint32_t)glue, glueMax));
+		}
 
 		double m_ClsDelOneTierActivityIncrease = 1.0;
 		void ClsDeletionInit();
@@ -2884,6 +3283,27 @@ protected:
 		TPhaseStage m_PhaseInitStage = TPhaseStage::PHASE_STAGE_STANDARD;
 		inline string GetPhaseStageStr() const { return m_PhaseStage == TPhaseStage::PHASE_STAGE_STANDARD ? "Standard" : "Don't-force"; }
 
+		// Target and best phases: the saved phases of the longest conflict-free trail since the last rephasing (target) or since the last best-rephasing (best)
+		TUV m_PhaseTargetAssigned = 0;
+		TUV m_PhaseBestAssigned = 0;
+		inline bool IsPhaseTargetOrBestOn() const { return m_ParamPhaseTarget != 0 || m_ParamPhaseRephaseInterval != 0; }
+		inline bool IsPhaseTargetOn() const { return m_ParamPhaseTarget == 2 || (m_ParamPhaseTarget == 1 && m_CurrRestartStrat == RESTART_STRAT_MODES && m_RstModeIsStable); }
+		// Invoked after backtracking to the highest level of a contradicting clause, so the trail up to that level is conflict-free
+		void PhaseUpdateTargetAndBest(TUV conflictFreeAssigned);
+		// Rephasing
+		enum class TRephaseType : uint8_t
+		{
+			REPHASE_ORIGINAL,
+			REPHASE_INVERTED,
+			REPHASE_BEST,
+			REPHASE_RANDOM
+		};
+		static constexpr TRephaseType m_RephaseCycle[] = { TRephaseType::REPHASE_ORIGINAL, TRephaseType::REPHASE_BEST, TRephaseType::REPHASE_INVERTED, TRephaseType::REPHASE_BEST, TRephaseType::REPHASE_RANDOM, TRephaseType::REPHASE_BEST };
+		uint64_t m_PhaseRephases = 0;
+		uint64_t m_PhaseRephaseNextConf = 0;
+		// Invoked after restarts
+		void PhaseRephaseIfRequired();
+
 		/*
 		* DRAT
 		*/
@@ -2913,8 +3333,44 @@ protected:
 		* Inprocessing
 		*/
 
+		// The scheduler: runs every enabled registered technique within its budget
 		void InprocessIfRequired();
-		void IngRemoveBinaryWatchesIfRequired();
+		// The conflict-based conditions for inprocessing hold (disregarding the decision level)
+		bool IsInprocessingDue() const;
+		
+		// The techniques: each one gets a budget in implications (ticks) and returns the number of clauses and literals it removed
+		uint64_t IngRemoveDuplicateBinWatches(uint64_t implicationsBudget);
+		uint64_t IngVivify(uint64_t implicationsBudget);
+		uint64_t IngProbe(uint64_t implicationsBudget);
+		// Subsumption: the budget is in steps, counted in m_IngSteps
+		uint64_t IngSubsume(uint64_t stepsBudget);
+		// Probing: substitute the equivalent literals (the strongly connected components of the binary implication graph); returns the number of substituted variables
+		uint64_t IngSubstituteEquivalences();
+
+		// A registered technique
+		struct TIngTechniqueEntry
+		{
+			TIngTechnique m_Technique;
+			// Is the technique enabled and applicable?
+			bool m_IsOn;
+			// Non-budgeted techniques run to completion without touching their effort scale
+			bool m_IsBudgeted;
+			// The budget is the number of implications since the technique's previous run multiplied by m_Effort and the technique's effort scale, but at least m_MinEffort
+			double m_Effort;
+			uint64_t m_MinEffort;
+			uint64_t (CTopi::*m_Run)(uint64_t implicationsBudget);
+		};
+		void IngRunTechnique(const TIngTechniqueEntry& te);
+
+		// The scheduler's state per technique
+		struct TIngTechniqueSched
+		{
+			// The current scale of the technique's effort
+			double m_EffortScale = 1.;
+			// m_Stat.m_Implications at the end of the technique's previous run
+			uint64_t m_LastImplications = 0;
+		};
+		array<TIngTechniqueSched, (size_t)TIngTechnique::ING_TECHNIQUES_NUM> m_IngSched = {};
 		
 		// m_Stat.m_SolveInvs last time inprocessing was invoked
 		uint64_t m_IngLastSolveInv = 0;
@@ -2922,6 +3378,39 @@ protected:
 		uint64_t m_IngLastConflicts = 0;
 		// m_Stat.m_EverAddedBinaryClss last time inprocessing was invoked
 		uint64_t m_IngLastEverAddedBinaryClss = 0;
+		// The work of the techniques, which don't propagate, in steps; the scheduler counts it as ticks on top of the implications
+		uint64_t m_IngSteps = 0;
+
+		/*
+		* Preprocessing: bounded variable elimination
+		*/
+
+		// Eliminate variables, if required; invoked at decision level 0 before the search
+		void BveIfRequired(const span<TLit> userAssumps);
+		// Set the values of the eliminated variables: reconstruct them from the elimination stack, if the query is satisfiable, and make them unassigned otherwise
+		void BveExtendModel();
+		// Bring back all the eliminated variables by adding their clauses back
+		void BveRestoreAll();
+		// Is the external variable eliminated?
+		inline bool BveIsEliminated(TLit vExternal) const { return (size_t)vExternal < m_BveElimVals.cap() && m_BveElimVals[vExternal] != TToporLitVal::VAL_DONT_CARE; }
+		// Are any of the literals' variables eliminated?
+		inline bool BveIsAnyEliminated(const span<TLit> c) const 
+		{ 
+			return !m_BveElimExtVars.empty() && any_of(c.begin(), c.end(), [&](TLit l) { return l != 0 && BveIsEliminated(ExternalLit2ExternalVar(l)); });
+		}
+
+		// The elimination stack: every removed clause in external literals, starting with the literal of the eliminated variable (the witness), followed by the clause size
+		CVector<TLit> m_BveStack;
+		// The eliminated external variables
+		CVector<TLit> m_BveElimExtVars;
+		// Per external variable: VAL_DONT_CARE, if not eliminated; otherwise, the reconstructed value of the positive literal 
+		CDynArray<TToporLitVal> m_BveElimVals;
+		// Per external variable: the number of times it was frozen minus the number of times it was melted
+		CDynArray<uint32_t> m_FrozenExtVars;
+		// m_Stat.m_AddClauseInvs, when the previous elimination was invoked
+		uint64_t m_BveLastAddClauseInvs = numeric_limits<uint64_t>::max();
+		// Are the eliminated clauses being added back (they mustn't be dumped)?
+		bool m_BveIsRestoring = false;
 		
 		/*
 		* Debugging
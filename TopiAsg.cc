@@ -66,30 +66,30 @@ bool CTopi<TLit,TUInd,Compress>::Assign(TULit l, TUInd parentClsInd, TULit other
 
 	// It is either that: (1) The trail is empty, or (2) The level is 0, or (3) A new level is started, or (4) The level is non-empty
 	// So, there cannot be an empty intermediate level
-	assert(m_TrailEnd == BadUVar || decLevel == 0 || decLevel == m_DecLevel || m_TrailLastVarPerDecLevel[decLevel] != BadUVar);
+	assert(m_Trail.empty() || decLevel == 0 || decLevel == m_DecLevel || !DecLevelIsCollapsed(decLevel));
 
-	TUVar trailPrev = m_TrailLastVarPerDecLevel[decLevel] == BadUVar && decLevel != 0 ? m_TrailEnd : m_TrailLastVarPerDecLevel[decLevel];	
-	TUVar trailNext = BadUVar;
-
-	if (unlikely(trailPrev == BadUVar))
-	{
-		trailNext = m_TrailStart;
-		m_TrailStart = v;
-	}
-	else
+	if (unlikely(m_Trail.size() == m_Trail.cap()))
 	{
-		trailNext = m_VarInfo[trailPrev].m_TrailNext;
-		m_VarInfo[trailPrev].m_TrailNext = v;
+		// Reclaim the holes
+		TrailCompact();
 	}
 
-	if (trailNext != BadUVar)
+	const TUV trailPos = (TUV)m_Trail.size();
+	if (likely(m_TrailSortedEnd == trailPos && decLevel >= m_TrailTopDecLevel))
 	{
-		m_VarInfo[trailNext].m_TrailPrev = v;
+		// The assignment extends the ordered prefix 
+		while (m_TrailTopDecLevel < decLevel)
+		{
+			m_TrailDecLevelStart[++m_TrailTopDecLevel] = trailPos;
+		}
+		++m_TrailSortedEnd;
 	}
 	else
 	{
-		m_TrailEnd = v;
+		// The assignment is out-of-order (below the highest decision level); it will be moved to its place by TrailCompact
+		m_TrailDirtyDecLevel = min(m_TrailDirtyDecLevel, decLevel);
 	}
+	m_Trail.push_back(v);
 
 	if (m_ParamPhaseBoostFlippedForced && IsForced(v) && m_PolarityInfo[v].GetNextPolarityIsNegated() != IsNeg(l))
 	{
@@ -97,9 +97,12 @@ bool CTopi<TLit,TUInd,Compress>::Assign(TULit l, TUInd parentClsInd, TULit other
 	}
 
 	m_AssignmentInfo[v].Assign(IsNeg(l), parentClsInd, otherWatch);
-	m_VarInfo[v].Assign(parentClsInd, otherWatch, decLevel, trailPrev, trailNext);
-
-	m_TrailLastVarPerDecLevel[decLevel] = v;
+	m_VarInfo[v].Assign(parentClsInd, otherWatch, decLevel, trailPos);
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
+	{
+		m_LrbInfo[v].m_AssignedConf = m_LrbInfo[v].m_ParticipatedConf = m_Stat.m_Conflicts;
+		m_LrbInfo[v].m_Participated = 0;
+	}
 
 	if (toPropagate)
 	{
@@ -144,49 +147,125 @@ void CTopi<TLit,TUInd,Compress>::UnassignVar(TUVar v)
 	assert(v < m_VarInfo.cap());
 	assert(m_AssignmentInfo[v].m_IsAssigned);
 
-	if (m_VarInfo[v].m_TrailNext != BadUVar)
+	const TUV trailPos = m_VarInfo[v].m_TrailPos;
+	assert(trailPos < m_Trail.size() && m_Trail[trailPos] == v);
+
+	if (trailPos == m_Trail.size() - 1)
 	{
-		m_VarInfo[m_VarInfo[v].m_TrailNext].m_TrailPrev = m_VarInfo[v].m_TrailPrev;
+		m_Trail.pop_back();
+		if (trailPos < m_TrailSortedEnd)
+		{
+			m_TrailSortedEnd = trailPos;
+			while (m_TrailTopDecLevel > 0 && m_TrailDecLevelStart[m_TrailTopDecLevel] > trailPos)
+			{
+				--m_TrailTopDecLevel;
+			}
+		}
 	}
 	else
 	{
-		assert(m_TrailEnd == v);
-		m_TrailEnd = m_VarInfo[v].m_TrailPrev;
+		// Leave a hole to be removed by TrailCompact
+		m_Trail[trailPos] = BadUVar;
+		m_TrailDirtyDecLevel = min(m_TrailDirtyDecLevel, GetAssignedDecLevelVar(v));
 	}
-	if (m_VarInfo[v].m_TrailPrev != BadUVar)
+
+	m_AssignmentInfo[v].Unassign();
+
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
 	{
-		m_VarInfo[m_VarInfo[v].m_TrailPrev].m_TrailNext = m_VarInfo[v].m_TrailNext;
+		LrbOnUnassign(v);
 	}
-	else
+	m_VsidsHeap.reinsert_if_not_in_heap(v);
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
 	{
-		assert(m_TrailStart == v);
-		m_TrailStart = m_VarInfo[v].m_TrailNext;
+		m_Vmtf.on_unassign(v);
 	}
 
-	const TUV lDecLevel = GetAssignedDecLevelVar(v);
+	if (unlikely(GetVar(m_FlippedLit) == v))
+	{
+		m_FlippedLit = BadULit;
+	}
 
-	if (m_TrailLastVarPerDecLevel[lDecLevel] == v)
+	--m_AssignedVarsNum;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::TrailCompact()
+{
+	if (TrailIsCompact())
 	{
-		if (m_VarInfo[v].m_TrailPrev == BadUVar || GetAssignedDecLevelVar(m_VarInfo[v].m_TrailPrev) != lDecLevel)
+		return;
+	}
+
+	// A stable counting sort by the decision level of the trail part, starting at the lowest decision level, which isn't in order, while skipping the holes
+	const TUV fromDecLevel = min(m_TrailDirtyDecLevel, m_TrailTopDecLevel);
+	const TUV from = m_TrailDecLevelStart[fromDecLevel];
+	const auto trailSpan = m_Trail.get_span(from);
+	if (unlikely(trailSpan.size() > m_TrailCompactBuffer.cap()))
+	{
+		// The trail might have grown beyond the variable data before the first Solve 
+		ReserveExactly(m_TrailCompactBuffer, m_Trail.cap(), "m_TrailCompactBuffer in TrailCompact");
+		if (unlikely(IsUnrecoverable())) return;
+	}
+	
+	TUV maxDecLevel = fromDecLevel;
+	for (TUVar v : trailSpan)
+	{
+		if (v != BadUVar && GetAssignedDecLevelVar(v) > maxDecLevel)
 		{
-			m_TrailLastVarPerDecLevel[lDecLevel] = BadUVar;
+			maxDecLevel = GetAssignedDecLevelVar(v);
 		}
-		else
+	}
+
+	// Count the variables per decision level (reusing m_TrailDecLevelStart)
+	for (TUV decLevel = fromDecLevel; decLevel <= maxDecLevel; ++decLevel)
+	{
+		m_TrailDecLevelStart[decLevel] = 0;
+	}
+	for (TUVar v : trailSpan)
+	{
+		if (v != BadUVar)
 		{
-			m_TrailLastVarPerDecLevel[lDecLevel] = m_VarInfo[v].m_TrailPrev;
+			++m_TrailDecLevelStart[GetAssignedDecLevelVar(v)];
 		}
 	}
 
-	m_AssignmentInfo[v].Unassign();
+	// Convert the counters into the decision level starts
+	TUV newSize = from;
+	for (TUV decLevel = fromDecLevel; decLevel <= maxDecLevel; ++decLevel)
+	{
+		const TUV decLevelVars = m_TrailDecLevelStart[decLevel];
+		m_TrailDecLevelStart[decLevel] = newSize;
+		newSize += decLevelVars;
+	}
 
-	m_VsidsHeap.reinsert_if_not_in_heap(v);
+	// Scatter; m_TrailDecLevelStart[decLevel] is moved to the end of decLevel
+	for (TUVar v : trailSpan)
+	{
+		if (v != BadUVar)
+		{
+			m_TrailCompactBuffer[m_TrailDecLevelStart[GetAssignedDecLevelVar(v)]++ - from] = v;
+		}
+	}
 
-	if (unlikely(GetVar(m_FlippedLit) == v))
+	// Restore the decision level starts
+	for (TUV decLevel = maxDecLevel; decLevel > fromDecLevel; --decLevel)
 	{
-		m_FlippedLit = BadULit;
+		m_TrailDecLevelStart[decLevel] = m_TrailDecLevelStart[decLevel - 1];
 	}
+	m_TrailDecLevelStart[fromDecLevel] = from;
 
-	--m_AssignedVarsNum;
+	for (TUV trailPos = from; trailPos < newSize; ++trailPos)
+	{
+		const TUVar v = m_TrailCompactBuffer[trailPos - from];
+		m_Trail[trailPos] = v;
+		m_VarInfo[v].m_TrailPos = trailPos;
+	}
+
+	m_Trail.resize(newSize);
+	m_TrailSortedEnd = newSize;
+	m_TrailTopDecLevel = maxDecLevel;
+	m_TrailDirtyDecLevel = numeric_limits<TUV>::max();
 }
 
 template <typename TLit, typename TUInd, bool Compress>
@@ -287,26 +366,87 @@ void CTopi<TLit,TUInd,Compress>::ClearUserPolarityInfo(TLit vExternal)
 	}
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::Freeze(TLit lExternal)
+{
+	//	cout << "\tc lz <FreezeLit>" << endl;
+	if (m_DumpFile) (*m_DumpFile) << "lz " << lExternal << endl;
+	const TLit vExternal = ExternalLit2ExternalVar(lExternal);
+
+	if (unlikely(IsUnrecoverable())) return;
+
+	if (BveIsEliminated(vExternal))
+	{
+		BveRestoreAll();
+		if (unlikely(IsUnrecoverable())) return;
+	}
+
+	if ((size_t)vExternal >= m_FrozenExtVars.cap())
+	{
+		m_FrozenExtVars.reserve_atleast((size_t)vExternal + 1, 0);
+		if (unlikely(m_FrozenExtVars.uninitialized_or_erroneous()))
+		{
+			SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "Freeze: couldn't reserve m_FrozenExtVars");
+			return;
+		}
+	}
+
+	++m_FrozenExtVars[vExternal];
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::Melt(TLit lExternal)
+{
+	//	cout << "\tc lm <MeltLit>" << endl;
+	if (m_DumpFile) (*m_DumpFile) << "lm " << lExternal << endl;
+	const TLit vExternal = ExternalLit2ExternalVar(lExternal);
+
+	if ((size_t)vExternal < m_FrozenExtVars.cap() && m_FrozenExtVars[vExternal] > 0)
+	{
+		--m_FrozenExtVars[vExternal];
+	}
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 bool CTopi<TLit,TUInd,Compress>::TrailAssertConsistency()
 {
-	for (auto [nextIndStartDecLevel, v] = make_tuple(false, m_TrailStart); v != BadUVar; v = m_VarInfo[v].m_TrailNext)
+	[[maybe_unused]] const bool c0 = m_TrailSortedEnd <= m_Trail.size() && m_TrailDecLevelStart[0] == 0 && m_TrailDecLevelStart[m_TrailTopDecLevel] <= m_TrailSortedEnd &&
+		(!TrailIsCompact() || m_TrailSortedEnd == m_Trail.size());
+	assert(c0 || P("***** TrailAssertConsistency failure 0: " + STrail() + "\n"));
+	assert(c0);
+
+	for (TUV decLevel = 1; decLevel <= m_TrailTopDecLevel; ++decLevel)
 	{
-		[[maybe_unused]] const TULit l = GetAssignedLitForVar(v);
-		[[maybe_unused]] const TUVar vTrailNext = m_VarInfo[v].m_TrailNext;
-		
-		[[maybe_unused]] const bool c1 = (vTrailNext == BadUVar && m_TrailEnd == v) || (vTrailNext != BadUVar && m_VarInfo[vTrailNext].m_TrailPrev == v);
-		assert(c1 || P("***** TrailAssertConsistency failure: " + STrail() + "\n"));
+		[[maybe_unused]] const bool c1 = m_TrailDecLevelStart[decLevel - 1] <= m_TrailDecLevelStart[decLevel];
+		assert(c1 || P("***** TrailAssertConsistency failure 1: " + STrail() + "\n"));
 		assert(c1);
+	}
+
+	[[maybe_unused]] TUV assignedVarsNum = 0;
+	for (TUV trailPos = 0; trailPos < (TUV)m_Trail.size(); ++trailPos)
+	{
+		const TUVar v = m_Trail[trailPos];
+		if (v == BadUVar)
+		{
+			assert(!TrailIsCompact() || P("***** TrailAssertConsistency failure: a hole in a compact trail: " + STrail() + "\n"));
+			assert(!TrailIsCompact());
+			continue;
+		}
+
+		++assignedVarsNum;
 		
 		[[maybe_unused]] const TUV vDecLevel = GetAssignedDecLevelVar(v);
-		[[maybe_unused]] const TUV nextDecLevel = vTrailNext == BadUVar ? numeric_limits<TUV>::max() : GetAssignedDecLevelVar(vTrailNext);
-
-		[[maybe_unused]] const bool c2 = vDecLevel == nextDecLevel || m_TrailLastVarPerDecLevel[vDecLevel] == v;
-		assert(c2 || P("***** TrailAssertConsistency failure 2: " + STrail() + "\n"));
+		[[maybe_unused]] const bool c2 = IsAssignedVar(v) && m_VarInfo[v].m_TrailPos == trailPos && (trailPos < m_TrailSortedEnd ? 
+			vDecLevel <= m_TrailTopDecLevel && TrailDecLevelStart(vDecLevel) <= trailPos && trailPos < TrailDecLevelEnd(vDecLevel) :
+			vDecLevel >= m_TrailDirtyDecLevel);
+		assert(c2 || P("***** TrailAssertConsistency failure 2 at " + to_string(trailPos) + ": " + STrail() + "\n"));
 		assert(c2);
 	}
 
+	[[maybe_unused]] const bool c3 = assignedVarsNum == m_AssignedVarsNum;
+	assert(c3 || P("***** TrailAssertConsistency failure 3: " + STrail() + "\n"));
+	assert(c3);
+
 	/*[[maybe_unused]] auto vvSpan = m_VisitedVars.get_span();
 	[[maybe_unused]] auto rvSpan = m_RootedVars.get_span();
 
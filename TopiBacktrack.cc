@@ -32,8 +32,10 @@ void CTopi<TLit,TUInd,Compress>::Backtrack(TLit decLevelL, bool isBCPBacktrack,
 	if (isBCPBacktrack) ++m_Stat.m_BCPBacktracks;
 	m_Stat.m_ChronoBacktracks += (decLevel == m_DecLevel - 1);	
 
+	TrailCompact();
+
 	// Cleaning up collapsed decision levels
-	while (decLevel != 0 && m_TrailLastVarPerDecLevel[decLevel] == BadClsInd)
+	while (DecLevelIsCollapsed(decLevel))
 	{
 		if (decLevel == m_DecLevelOfLastAssignedAssumption)
 		{
@@ -42,9 +44,32 @@ void CTopi<TLit,TUInd,Compress>::Backtrack(TLit decLevelL, bool isBCPBacktrack,
 		--decLevel;
 	}
 
-	while (m_TrailEnd != m_TrailLastVarPerDecLevel[decLevel])
+	if (m_ParamTrailSaving && !isBCPBacktrack && !isAPICall)
+	{
+		SavedTrailSave(decLevel);
+		if (unlikely(IsUnrecoverable())) return;
+	}
+
+	// LRB updates the scores of the unassigned variables, which requires a valid heap
+	const bool bulkReinsert = m_CurrDecisionStrat != DECISION_STRAT_LRB && (double)(m_Trail.size() - TrailDecLevelEnd(decLevel)) > m_ParamBulkReinsertFraction * (double)GetNextVar();
+	if (bulkReinsert)
+	{
+		m_VsidsHeap.bulk_reinsert_start();
+	}
+
+	while (m_Trail.size() > TrailDecLevelEnd(decLevel))
+	{
+		UnassignVar(m_Trail.back());
+	}
+
+	if (bulkReinsert)
+	{
+		m_VsidsHeap.bulk_reinsert_finish();
+	}
+
+	if (m_TrailTopDecLevel > decLevel)
 	{
-		UnassignVar(m_TrailEnd);
+		m_TrailTopDecLevel = decLevel;
 	}
 		
 	m_DecLevel = decLevel;
@@ -52,6 +77,89 @@ void CTopi<TLit,TUInd,Compress>::Backtrack(TLit decLevelL, bool isBCPBacktrack,
 	assert(NV(2) || P("***** Backtracked to " + to_string(m_DecLevel) + "\n"));	
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::SavedTrailSave(TUV decLevel)
+{
+	SavedTrailInvalidate();
+	// The trail is compact, so it's ordered by the decision levels
+	for (TUV trailPos = TrailDecLevelEnd(decLevel); trailPos < (TUV)m_Trail.size(); ++trailPos)
+	{
+		const TUVar v = m_Trail[trailPos];
+		const auto& vi = m_VarInfo[v];
+		const bool isBin = m_AssignmentInfo[v].IsAssignedBinary();
+		m_SavedTrail.push_back(TSavedImplication{ GetAssignedLitForVar(v), isBin ? vi.m_BinOtherLit : BadULit, isBin ? BadClsInd : vi.m_ParentClsInd });
+	}
+
+	if (unlikely(m_SavedTrail.uninitialized_or_erroneous()))
+	{
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "SavedTrailSave: couldn't save the trail");
+		return;
+	}
+
+	if (!m_SavedTrail.empty() && !m_SavedTrail[0].IsDecision())
+	{
+		// Can happen only if the first backtracked level was collapsed
+		SavedTrailInvalidate();
+	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::SavedTrailReplay(TULit decLit)
+{
+	if (m_SavedTrailNext >= m_SavedTrail.size())
+	{
+		return;
+	}
+
+	if (m_SavedTrail[m_SavedTrailNext].m_Lit != decLit)
+	{
+		// A different decision was taken
+		SavedTrailInvalidate();
+		return;
+	}
+
+	for (++m_SavedTrailNext; m_SavedTrailNext < m_SavedTrail.size() && !m_SavedTrail[m_SavedTrailNext].IsDecision(); ++m_SavedTrailNext)
+	{
+		const TSavedImplication& si = m_SavedTrail[m_SavedTrailNext];
+		if (IsSatisfied(si.m_Lit))
+		{
+			continue;
+		}
+
+		// The reason holds, if the implied literal is unassigned, while the rest of the clause is falsified with at least one literal at the current level,
+		// where a long parent's literal must still be watched (in which case, the other watch must be assigned at the current level)
+		bool isReasonValid = false;
+		TULit otherWatch = si.m_BinOtherLit;
+		if (!IsAssigned(si.m_Lit))
+		{
+			if (si.m_ParentClsInd == BadClsInd)
+			{
+				isReasonValid = IsFalsified(otherWatch) && GetAssignedDecLevel(otherWatch) == m_DecLevel;
+			}
+			else
+			{
+				const auto cls = ConstClsSpan(si.m_ParentClsInd);
+				if (cls[0] == si.m_Lit || cls[1] == si.m_Lit)
+				{
+					otherWatch = cls[0] == si.m_Lit ? cls[1] : cls[0];
+					isReasonValid = IsFalsified(otherWatch) && GetAssignedDecLevel(otherWatch) == m_DecLevel &&
+						all_of(cls.begin() + 2, cls.end(), [&](TULit l) { return IsFalsified(l); });
+				}
+			}
+		}
+
+		if (!isReasonValid)
+		{
+			// The rest of the saved implications are likely to depend on this one, so leave them to BCP
+			SavedTrailInvalidate();
+			return;
+		}
+
+		Assign(si.m_Lit, si.m_ParentClsInd, otherWatch, m_DecLevel);
+		++m_Stat.m_TrailSavingReplayed;
+	}
+}
+
 template class Topor::CTopi<int32_t, uint32_t, false>;
 template class Topor::CTopi<int32_t, uint64_t, false>;
 template class Topor::CTopi<int32_t, uint64_t, true>;
@@ -9,9 +9,147 @@
 #include "Topi.hpp"
 #include "SetInScope.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TOPI_WL_CAND_SIMD
+#include <immintrin.h>
+#endif
+
 using namespace Topor;
 using namespace std;
 
+#ifdef TOPI_WL_CAND_SIMD
+// Vectorized kernels for FindBestWLCand over a block-aligned prefix of the clause's literals (the caller handles the tail)
+// Each lane gathers the 4-byte word, containing the variable's assignment info, from the byte array aiBytes (its capacity is rounded up by AssignmentInfoCap, so that the word is always within the array)
+// and the decision level from the m_VarInfo array (decLevels points to the first decision level; decLevelStride is the size of an entry in 4-byte words)
+// Returns the index of the first non-falsified literal or litsNum, if all the literals are falsified; 
+// in the latter case, bestInd & bestDecLevel are updated with the first literal, whose decision level is at least maxDecLevel, or, otherwise, the first literal of the highest decision level
+__attribute__((target("avx2"))) static size_t FindBestWLCandAvx2(const uint32_t* lits, size_t litsNum, const uint8_t* aiBytes, uint8_t assignedBit, uint8_t negatedBit,
+	const int32_t* decLevels, int32_t decLevelStride, uint32_t maxDecLevel, size_t& bestInd, uint32_t& bestDecLevel)
+{
+	const int32_t* aiWords = (const int32_t*)aiBytes;
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i three = _mm256_set1_epi32(3);
+	const __m256i stride = _mm256_set1_epi32(decLevelStride);
+	const __m128i assignedShift = _mm_cvtsi32_si128(assignedBit);
+	const __m128i negatedShift = _mm_cvtsi32_si128(negatedBit);
+
+	for (size_t i = 0; i + 8 <= litsNum; i += 8)
+	{
+		const __m256i l = _mm256_loadu_si256((const __m256i*)(lits + i));
+		const __m256i v = _mm256_srli_epi32(l, 1);
+		// Move the assignment info of each variable to the lowest byte of its lane
+		const __m256i ai = _mm256_srlv_epi32(_mm256_i32gather_epi32(aiWords, _mm256_srli_epi32(v, 2), 4), _mm256_slli_epi32(_mm256_and_si256(v, three), 3));
+		const __m256i isAssigned = _mm256_and_si256(_mm256_srl_epi32(ai, assignedShift), one);
+		const __m256i isNegated = _mm256_and_si256(_mm256_srl_epi32(ai, negatedShift), one);
+		const __m256i isFalsified = _mm256_and_si256(isAssigned, _mm256_xor_si256(isNegated, _mm256_and_si256(l, one)));
+		const uint32_t nonFalsifiedMask = ~(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(isFalsified, one))) & 0xFF;
+		if (nonFalsifiedMask != 0)
+		{
+			return i + countr_zero(nonFalsifiedMask);
+		}
+
+		if (bestDecLevel < maxDecLevel)
+		{
+			const __m256i dl = _mm256_i32gather_epi32(decLevels, _mm256_mullo_epi32(v, stride), 4);
+			// dl > bestDecLevel <=> max(dl, bestDecLevel + 1) == dl (unsigned)
+			const __m256i isHigher = _mm256_cmpeq_epi32(_mm256_max_epu32(dl, _mm256_set1_epi32(bestDecLevel + 1)), dl);
+			if (_mm256_movemask_ps(_mm256_castsi256_ps(isHigher)) != 0)
+			{
+				alignas(32) uint32_t dls[8];
+				_mm256_store_si256((__m256i*)dls, dl);
+				for (size_t j = 0; j < 8 && bestDecLevel < maxDecLevel; ++j)
+				{
+					if (dls[j] > bestDecLevel)
+					{
+						bestDecLevel = dls[j];
+						bestInd = i + j;
+					}
+				}
+			}
+		}
+	}
+
+	return litsNum;
+}
+
+// GCC's AVX-512 intrinsics initialize undefined vectors with themselves, which triggers a false -Wmaybe-uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f"))) static size_t FindBestWLCandAvx512(const uint32_t* lits, size_t litsNum, const uint8_t* aiBytes, uint8_t assignedBit, uint8_t negatedBit,
+	const int32_t* decLevels, int32_t decLevelStride, uint32_t maxDecLevel, size_t& bestInd, uint32_t& bestDecLevel)
+{
+	const int32_t* aiWords = (const int32_t*)aiBytes;
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512i three = _mm512_set1_epi32(3);
+	const __m512i stride = _mm512_set1_epi32(decLevelStride);
+	const __m128i assignedShift = _mm_cvtsi32_si128(assignedBit);
+	const __m128i negatedShift = _mm_cvtsi32_si128(negatedBit);
+
+	for (size_t i = 0; i + 16 <= litsNum; i += 16)
+	{
+		const __m512i l = _mm512_loadu_si512((const void*)(lits + i));
+		const __m512i v = _mm512_srli_epi32(l, 1);
+		// Move the assignment info of each variable to the lowest byte of its lane
+		const __m512i ai = _mm512_srlv_epi32(_mm512_i32gather_epi32(_mm512_srli_epi32(v, 2), aiWords, 4), _mm512_slli_epi32(_mm512_and_si512(v, three), 3));
+		const __m512i isAssigned = _mm512_and_si512(_mm512_srl_epi32(ai, assignedShift), one);
+		const __m512i isNegated = _mm512_and_si512(_mm512_srl_epi32(ai, negatedShift), one);
+		const __m512i isFalsified = _mm512_and_si512(isAssigned, _mm512_xor_si512(isNegated, _mm512_and_si512(l, one)));
+		const uint32_t nonFalsifiedMask = _mm512_cmpneq_epi32_mask(isFalsified, one);
+		if (nonFalsifiedMask != 0)
+		{
+			return i + countr_zero(nonFalsifiedMask);
+		}
+
+		if (bestDecLevel < maxDecLevel)
+		{
+			const __m512i dl = _mm512_i32gather_epi32(_mm512_mullo_epi32(v, stride), decLevels, 4);
+			if (_mm512_cmpgt_epu32_mask(dl, _mm512_set1_epi32(bestDecLevel)) != 0)
+			{
+				alignas(64) uint32_t dls[16];
+				_mm512_store_si512((void*)dls, dl);
+				for (size_t j = 0; j < 16 && bestDecLevel < maxDecLevel; ++j)
+				{
+					if (dls[j] > bestDecLevel)
+					{
+						bestDecLevel = dls[j];
+						bestInd = i + j;
+					}
+				}
+			}
+		}
+	}
+
+	return litsNum;
+}
+#pragma GCC diagnostic pop
+#endif
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::BCPInit()
+{
+	const bool chronoBt = m_CurrChronoBtIfHigher != numeric_limits<TUV>::max();
+	m_BCPFifo = m_ParamBCPPropagationOrder == 1;
+	m_BCPKernel = m_BCPFifo ?
+		(m_ParamSimplify ? (chronoBt ? &CTopi::BCPKernel<true, true, true> : &CTopi::BCPKernel<true, false, true>) : (chronoBt ? &CTopi::BCPKernel<false, true, true> : &CTopi::BCPKernel<false, false, true>)) :
+		(m_ParamSimplify ? (chronoBt ? &CTopi::BCPKernel<true, true, false> : &CTopi::BCPKernel<true, false, false>) : (chronoBt ? &CTopi::BCPKernel<false, true, false> : &CTopi::BCPKernel<false, false, false>));
+
+	m_WLCandSimd = 0;
+#ifdef TOPI_WL_CAND_SIMD
+	if constexpr (!Compress && sizeof(TULit) == sizeof(uint32_t) && sizeof(TUV) == sizeof(uint32_t) && sizeof(TVarInfo) % sizeof(int32_t) == 0)
+	{
+		__builtin_cpu_init();
+		if (m_ParamWLCandSimd >= 2 && __builtin_cpu_supports("avx512f"))
+		{
+			m_WLCandSimd = 2;
+		}
+		else if (m_ParamWLCandSimd >= 1 && __builtin_cpu_supports("avx2"))
+		{
+			m_WLCandSimd = 1;
+		}
+	}
+#endif
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit, TUInd, Compress>::SwapWatch(const TUInd clsInd, bool watchInd, typename CCls::TIterator newWatchIt)
 {
@@ -42,6 +180,54 @@ void CTopi<TLit, TUInd, Compress>::SwapCurrWatch(TULit l, typename CCls::TIterat
 template <typename TLit, typename TUInd, bool Compress>
 CTopi<TLit, TUInd, Compress>::CCls::TIterator CTopi<TLit, TUInd, Compress>::FindBestWLCand(CCls& cls, TUV maxDecLevel)
 {
+#ifdef TOPI_WL_CAND_SIMD
+	if constexpr (!Compress && sizeof(TULit) == sizeof(uint32_t) && sizeof(TUV) == sizeof(uint32_t) && sizeof(TVarInfo) % sizeof(int32_t) == 0)
+	{
+		constexpr int32_t decLevelStride = (int32_t)(sizeof(TVarInfo) / sizeof(int32_t));
+		// The gathers use 32-bit indices
+		if (m_WLCandSimd != 0 && cls.size() >= 2 + 8 && (size_t)GetNextVar() <= (size_t)numeric_limits<int32_t>::max() / decLevelStride)
+		{
+			static const uint8_t assignedBit = []() { TAssignmentInfo ai = {}; ai.m_IsAssigned = true; return (uint8_t)countr_zero(bit_cast<uint8_t>(ai)); }();
+			static const uint8_t negatedBit = []() { TAssignmentInfo ai = {}; ai.m_IsNegated = true; return (uint8_t)countr_zero(bit_cast<uint8_t>(ai)); }();
+
+			const auto litsIt = cls.begin() + 2;
+			const size_t litsNum = (size_t)(cls.end() - litsIt);
+			const uint32_t* lits = (const uint32_t*)to_address(litsIt);
+			const uint8_t* aiBytes = (const uint8_t*)m_AssignmentInfo.get_const_ptr();
+			const int32_t* decLevels = (const int32_t*)((const char*)m_VarInfo.get_const_ptr() + offsetof(TVarInfo, m_DecLevel));
+			size_t bestInd = 0;
+			uint32_t bestDecLevel = 0;
+
+			const size_t vectorizedLitsNum = m_WLCandSimd == 2 ? litsNum & ~(size_t)15 : litsNum & ~(size_t)7;
+			const size_t nonFalsifiedInd = m_WLCandSimd == 2 ?
+				FindBestWLCandAvx512(lits, vectorizedLitsNum, aiBytes, assignedBit, negatedBit, decLevels, decLevelStride, maxDecLevel, bestInd, bestDecLevel) :
+				FindBestWLCandAvx2(lits, vectorizedLitsNum, aiBytes, assignedBit, negatedBit, decLevels, decLevelStride, maxDecLevel, bestInd, bestDecLevel);
+			if (nonFalsifiedInd != vectorizedLitsNum)
+			{
+				return litsIt + nonFalsifiedInd;
+			}
+
+			// The tail
+			for (size_t i = vectorizedLitsNum; i < litsNum; ++i)
+			{
+				if (UnassignedOrSatisfied(litsIt[i]))
+				{
+					return litsIt + i;
+				}
+
+				const auto lDecLevel = GetAssignedDecLevel(litsIt[i]);
+				if (bestDecLevel < maxDecLevel && lDecLevel > bestDecLevel)
+				{
+					bestDecLevel = lDecLevel;
+					bestInd = i;
+				}
+			}
+
+			return litsIt + bestInd;
+		}
+	}
+#endif
+
 	auto visitedLitIt = find_if(cls.begin() + 2, cls.end(), [&](const TULit visitedLit)
 	{
 		return UnassignedOrSatisfied(visitedLit);
@@ -79,7 +265,7 @@ void CTopi<TLit, TUInd, Compress>::BCPBacktrack(TUV decLevel, bool eraseDecLevel
 
 	auto EraseLit = [&](TULit l) { return !IsAssigned(l) || (eraseDecLevel && GetAssignedDecLevel(l) == decLevel); };
 
-	m_ToPropagate.erase_if_may_reorder([&](TULit l)
+	auto EraseAndMarkLit = [&](TULit l)
 	{
 		assert(!IsAssigned(l) || GetAssignedDecLevel(l) <= decLevel);
 		const bool eraseLit = EraseLit(l);
@@ -90,7 +276,31 @@ void CTopi<TLit, TUInd, Compress>::BCPBacktrack(TUV decLevel, bool eraseDecLevel
 			MarkVisited(l);
 		}
 		return eraseLit;
-	});
+	};
+
+	if (m_BCPFifo)
+	{
+		// Drop the fully propagated literals and erase the required ones, while preserving the order
+		size_t newSize = 0;
+		size_t newBinHead = 0;
+		for (size_t i = m_ToPropagateLongHead; i < m_ToPropagate.size(); ++i)
+		{
+			const TULit l = m_ToPropagate[i];
+			if (!EraseAndMarkLit(l))
+			{
+				m_ToPropagate[newSize++] = l;
+				newBinHead += i < m_ToPropagateBinHead;
+			}
+		}
+		m_ToPropagate.resize(newSize);
+		m_ToPropagateLongHead = 0;
+		m_ToPropagateBinHead = newBinHead;
+		m_ToPropagateSortByDecLevel = true;
+	}
+	else
+	{
+		m_ToPropagate.erase_if_may_reorder(EraseAndMarkLit);
+	}
 
 	assert(m_CurrentlyPropagatedLit != BadULit);
 	if (EraseLit(m_CurrentlyPropagatedLit))
@@ -100,87 +310,110 @@ void CTopi<TLit, TUInd, Compress>::BCPBacktrack(TUV decLevel, bool eraseDecLevel
 }
 
 template <typename TLit, typename TUInd, bool Compress>
-CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::BCP()
+bool CTopi<TLit, TUInd, Compress>::BCPNewContradiction(TContradictionInfo&& newCi)
 {
-	// Returns true iff BCP should stop propagating the current literal
-	auto NewContradiction = [&](TContradictionInfo&& newCi)
-	{
-		const TUV propagatedDecLevel = GetAssignedDecLevel(m_CurrentlyPropagatedLit);
-		// Assert that we indeed have a new contradiction, 
-		// where all the literals are falsified and the two first literals' decision level is higher than that of the rest
-		assert(CiIsLegal(newCi, false));
+	const TUV propagatedDecLevel = GetAssignedDecLevel(m_CurrentlyPropagatedLit);
+	// Assert that we indeed have a new contradiction, 
+	// where all the literals are falsified and the two first literals' decision level is higher than that of the rest
+	assert(CiIsLegal(newCi, false));
 
-		assert(NV(2) || P("***** previous contradictions = " + CisString(m_Cis.get_span()) + "\n"));
+	assert(NV(2) || P("***** previous contradictions = " + CisString(m_Cis.get_span()) + "\n"));
 
-		const auto newCiSpanFirst2Lits = CiGetSpan(newCi, 2);
-		const array<TUV, 2> newCiSpanDecLevels = { GetAssignedDecLevel(newCiSpanFirst2Lits[0]), GetAssignedDecLevel(newCiSpanFirst2Lits[1]) };
-		auto maxDecLevelInContradictingCls = max(newCiSpanDecLevels[0], newCiSpanDecLevels[1]);
+	const auto newCiSpanFirst2Lits = CiGetSpan(newCi, 2);
+	const array<TUV, 2> newCiSpanDecLevels = { GetAssignedDecLevel(newCiSpanFirst2Lits[0]), GetAssignedDecLevel(newCiSpanFirst2Lits[1]) };
+	auto maxDecLevelInContradictingCls = max(newCiSpanDecLevels[0], newCiSpanDecLevels[1]);
 
-		if (newCiSpanDecLevels[0] != newCiSpanDecLevels[1])
+	if (newCiSpanDecLevels[0] != newCiSpanDecLevels[1])
+	{
+		BCPBacktrack(maxDecLevelInContradictingCls - 1, false);
+		if (!m_Cis.empty())
 		{
-			BCPBacktrack(maxDecLevelInContradictingCls - 1, false);
-			if (!m_Cis.empty())
-			{
-				// Clear the previous contradictions, if any, which must be unassigned after the backtracking				
-				assert(all_of(m_Cis.get_span().begin(), m_Cis.get_span().end(), [&](TContradictionInfo& ci) { return !IsFalsified(CiGetSpanDebug(ci)[0]) && !IsFalsified(CiGetSpanDebug(ci)[1]); }));
-				m_Cis.clear();
-			}
-			assert(IsAssigned(newCiSpanFirst2Lits[0]) != IsAssigned(newCiSpanFirst2Lits[1]) || P("Failure: " + SLits((span<TULit>)newCiSpanFirst2Lits) + "; trail: " + STrail() + "\n"));
-			assert(IsAssigned(newCiSpanFirst2Lits[0]) != IsAssigned(newCiSpanFirst2Lits[1]));
-			const TULit unassignedLit = IsAssigned(newCiSpanFirst2Lits[0]) ? newCiSpanFirst2Lits[1] : newCiSpanFirst2Lits[0];
-			const TULit assignedLit = IsAssigned(newCiSpanFirst2Lits[0]) ? newCiSpanFirst2Lits[0] : newCiSpanFirst2Lits[1];
-			assert(IsFalsified(assignedLit));
-			if (!newCi.m_IsContradictionInBinaryCls && newCi.m_ParentClsInd != BadClsInd)
-			{
-				WLSetCached(assignedLit, newCi.m_ParentClsInd, unassignedLit);
-			}
-			Assign(unassignedLit, newCi.m_IsContradictionInBinaryCls ? BadClsInd : newCi.m_ParentClsInd, assignedLit, GetAssignedDecLevel(assignedLit));
-			assert(NV(2) || P("***** NewContradiction finished; stop-propagation = " + to_string(propagatedDecLevel > maxDecLevelInContradictingCls - 1) + ": turned out to be a delayed implication; to-propagate: " + SLits(m_ToPropagate.get_span()) + "; trail: " + STrail() + "\n"));
-			return propagatedDecLevel > maxDecLevelInContradictingCls - 1;
+			// Clear the previous contradictions, if any, which must be unassigned after the backtracking				
+			assert(all_of(m_Cis.get_span().begin(), m_Cis.get_span().end(), [&](TContradictionInfo& ci) { return !IsFalsified(CiGetSpanDebug(ci)[0]) && !IsFalsified(CiGetSpanDebug(ci)[1]); }));
+			m_Cis.clear();
 		}
-		else
+		assert(IsAssigned(newCiSpanFirst2Lits[0]) != IsAssigned(newCiSpanFirst2Lits[1]) || P("Failure: " + SLits((span<TULit>)newCiSpanFirst2Lits) + "; trail: " + STrail() + "\n"));
+		assert(IsAssigned(newCiSpanFirst2Lits[0]) != IsAssigned(newCiSpanFirst2Lits[1]));
+		const TULit unassignedLit = IsAssigned(newCiSpanFirst2Lits[0]) ? newCiSpanFirst2Lits[1] : newCiSpanFirst2Lits[0];
+		const TULit assignedLit = IsAssigned(newCiSpanFirst2Lits[0]) ? newCiSpanFirst2Lits[0] : newCiSpanFirst2Lits[1];
+		assert(IsFalsified(assignedLit));
+		if (!newCi.m_IsContradictionInBinaryCls && newCi.m_ParentClsInd != BadClsInd)
 		{
-			assert(m_Cis.empty() || all_of(m_Cis.get_span().begin(), m_Cis.get_span().end(), [&](TContradictionInfo& ci) { return maxDecLevelInContradictingCls <= GetAssignedDecLevel(CiGetSpan(ci)[0]) && maxDecLevelInContradictingCls <= GetAssignedDecLevel(CiGetSpan(ci)[1]); }));
-
-			BCPBacktrack(maxDecLevelInContradictingCls, true);
-
-			m_Cis.erase_if_may_reorder([&](TContradictionInfo& ci)
-			{
-				assert(ci.IsContradiction());
-				assert(IsAssigned(CiGetSpanDebug(ci)[0]) == IsAssigned(CiGetSpanDebug(ci)[1]));
-				return(!IsAssigned(CiGetSpanDebug(ci, 1)[0]));
-			});
-
-			m_Cis.emplace_back(move(newCi));
-
-			assert(NV(2) || P("***** NewContradiction finished; stop-propagation = " + to_string(propagatedDecLevel > maxDecLevelInContradictingCls - 1) + ": NOT a delayed implication; to-propagate = " + SLits(m_ToPropagate.get_span()) + "\n"));
-			return propagatedDecLevel >= maxDecLevelInContradictingCls;
+			WLSetCached(assignedLit, newCi.m_ParentClsInd, unassignedLit);
 		}
-	};
+		Assign(unassignedLit, newCi.m_IsContradictionInBinaryCls ? BadClsInd : newCi.m_ParentClsInd, assignedLit, GetAssignedDecLevel(assignedLit));
+		assert(NV(2) || P("***** NewContradiction finished; stop-propagation = " + to_string(propagatedDecLevel > maxDecLevelInContradictingCls - 1) + ": turned out to be a delayed implication; to-propagate: " + SLits(m_ToPropagate.get_span()) + "; trail: " + STrail() + "\n"));
+		return propagatedDecLevel > maxDecLevelInContradictingCls - 1;
+	}
+	else
+	{
+		assert(m_Cis.empty() || all_of(m_Cis.get_span().begin(), m_Cis.get_span().end(), [&](TContradictionInfo& ci) { return maxDecLevelInContradictingCls <= GetAssignedDecLevel(CiGetSpan(ci)[0]) && maxDecLevelInContradictingCls <= GetAssignedDecLevel(CiGetSpan(ci)[1]); }));
 
-	// Returns true iff BCP should stop propagating the current literal
-	assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
-	assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
+		BCPBacktrack(maxDecLevelInContradictingCls, true);
 
-	// assert(m_ParamAssertConsistency < 2 ||  P("DEBUG: " + SLits(GetCls(5304)) + "\n"));
-	CApplyFuncOnExitFromScope<> onExit([&]()
-	{
-		ToPropagateClear();
-		CleanVisited();
-		m_CurrentlyPropagatedLit = BadULit;
-		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
-		assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(m_Cis.empty()));
-		m_Cis.clear();
-	});
+		m_Cis.erase_if_may_reorder([&](TContradictionInfo& ci)
+		{
+			assert(ci.IsContradiction());
+			assert(IsAssigned(CiGetSpanDebug(ci)[0]) == IsAssigned(CiGetSpanDebug(ci)[1]));
+			return(!IsAssigned(CiGetSpanDebug(ci, 1)[0]));
+		});
 
-	++m_Stat.m_BCPs;
+		m_Cis.emplace_back(move(newCi));
 
-	assert(NV(2) || P("***** BCP started; #" + to_string(m_Stat.m_BCPs) + "\n"));
+		assert(NV(2) || P("***** NewContradiction finished; stop-propagation = " + to_string(propagatedDecLevel > maxDecLevelInContradictingCls - 1) + ": NOT a delayed implication; to-propagate = " + SLits(m_ToPropagate.get_span()) + "\n"));
+		return propagatedDecLevel >= maxDecLevelInContradictingCls;
+	}
+}
 
-	while (!m_ToPropagate.empty())
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::BCPSortToPropagateByDecLevel()
+{
+	// Trail order is preserved within each decision level
+	auto LitDecLevelLess = [&](TULit l1, TULit l2) { return GetDecLevel0ForUnassigned(l1) < GetDecLevel0ForUnassigned(l2); };
+	auto toPropagate = m_ToPropagate.get_span();
+	stable_sort(toPropagate.begin() + m_ToPropagateLongHead, toPropagate.begin() + m_ToPropagateBinHead, LitDecLevelLess);
+	stable_sort(toPropagate.begin() + m_ToPropagateBinHead, toPropagate.end(), LitDecLevelLess);
+	m_ToPropagateSortByDecLevel = false;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+template <bool Simplify, bool ChronoBt, bool Fifo>
+void CTopi<TLit, TUInd, Compress>::BCPKernel()
+{
+	for (;;)
 	{
 		bool stopPropagating = false;
-		m_CurrentlyPropagatedLit = ToPropagateBackAndPop();
+		// Breadth-first BCP propagates either the binary or the long watches of the current literal
+		bool isBinPhase = true;
+		if constexpr (Fifo)
+		{
+			if (unlikely(m_ToPropagateSortByDecLevel))
+			{
+				BCPSortToPropagateByDecLevel();
+			}
+
+			if (m_ToPropagateBinHead < m_ToPropagate.size())
+			{
+				m_CurrentlyPropagatedLit = m_ToPropagate[m_ToPropagateBinHead++];
+			}
+			else if (m_ToPropagateLongHead < m_ToPropagate.size())
+			{
+				m_CurrentlyPropagatedLit = m_ToPropagate[m_ToPropagateLongHead++];
+				isBinPhase = false;
+			}
+			else
+			{
+				break;
+			}
+		}
+		else
+		{
+			if (m_ToPropagate.empty())
+			{
+				break;
+			}
+			m_CurrentlyPropagatedLit = ToPropagateBackAndPop();
+		}
 
 		[[maybe_unused]] auto IsLStillPropagated = [&]() { return IsAssigned(m_CurrentlyPropagatedLit) && IsSatisfied(m_CurrentlyPropagatedLit); };
 
@@ -195,10 +428,31 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			continue;
 		}
 		const TUV lDecLevel = GetAssignedDecLevel(m_CurrentlyPropagatedLit);
-		++m_Stat.m_Implications;
-		if (m_ParamSimplify)
+		if constexpr (!ChronoBt)
 		{
-			--m_ImplicationsTillNextSimplify;
+			if (unlikely(lDecLevel != m_DecLevel))
+			{
+				// Out-of-order trail (e.g., because of the assumptions or a user clause added above level 0): 
+				// hand the rest of the propagation off to the kernel, which handles delayed implications
+				if constexpr (Fifo)
+				{
+					isBinPhase ? --m_ToPropagateBinHead : --m_ToPropagateLongHead;
+				}
+				else
+				{
+					ToPropagatePushBack(m_CurrentlyPropagatedLit);
+				}
+				BCPKernel<Simplify, true, Fifo>();
+				return;
+			}
+		}
+		if (isBinPhase)
+		{
+			++m_Stat.m_Implications;
+			if constexpr (Simplify)
+			{
+				--m_ImplicationsTillNextSimplify;
+			}
 		}
 
 		// Go over the binary watches first. We would like to pre-fetch the longs too for cache reasons, otherwise we would have used
@@ -207,7 +461,7 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 		TSpanTULit binWatches = TSpanTULit(allWatches + wi.GetLongEntries(), wi.m_BinaryWatches);
 
 		// Have to use an old-fashioned index-based for loop, since binWatches might change inside the loop because of reallocation
-		for (size_t otherWatchI = 0; otherWatchI < binWatches.size(); ++otherWatchI)
+		for (size_t otherWatchI = 0; isBinPhase && otherWatchI < binWatches.size(); ++otherWatchI)
 		{
 			const auto otherWatch = binWatches[otherWatchI];
 
@@ -224,13 +478,13 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			else if (isOtherWatchNegated)
 			{
 				// Contradiction				
-				stopPropagating = NewContradiction(TContradictionInfo({ Negate(m_CurrentlyPropagatedLit) , otherWatch }));
+				stopPropagating = BCPNewContradiction(TContradictionInfo({ Negate(m_CurrentlyPropagatedLit) , otherWatch }));
 				if (stopPropagating) break;
 			}
 			else
 			{
 				// Otherwise (that is, if both if conditions above do not hold), the clause is satisfied				
-				if (lDecLevel < m_DecLevel && GetAssignedDecLevel(otherWatch) > lDecLevel)
+				if (ChronoBt && lDecLevel < m_DecLevel && GetAssignedDecLevel(otherWatch) > lDecLevel)
 				{
 					// If the other watch is satisfied at a level higher than the current unsatisfied literal l, we have a delayed implication
 					stopPropagating = ProcessDelayedImplication(otherWatch, Negate(m_CurrentlyPropagatedLit), BadClsInd, m_Cis);
@@ -245,23 +499,24 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			}
 		}
 
-		// Go over the long watches		
-		for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); !stopPropagating && currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
+		// Go over the long watches (breadth-first BCP: only after the binary watches of all the pending literals have been propagated)
+		for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); !stopPropagating && (!Fifo || !isBinPhase) && currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 		{
 			TULit& cachedLit = *currLongWatchPtr;
 
-			assert(NV(2) || P("BCP: visiting long clause " + HexStr(*(TUInd*)(currLongWatchPtr + 1)) + ": cached " + SLit(cachedLit) + "; clause: " + SLits(Cls(*(TUInd*)(currLongWatchPtr + 1))) + "\n"));
+			assert(NV(2) || P("BCP: visiting long clause " + HexStr(WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1))) + ": cached " + SLit(cachedLit) + "; clause: " + SLits(Cls(WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1)))) + "\n"));
 			
-			if (IsSatisfied(cachedLit) && GetAssignedDecLevel(cachedLit) <= lDecLevel)
+			if (IsSatisfied(cachedLit) && (!ChronoBt || GetAssignedDecLevel(cachedLit) <= lDecLevel))
 			{
 				// The cached literal is satisfied at decision level not higher than the current watch, we can continue without visiting the clause!
 				continue;
 			}
 
-			// Fetching the clause
-			const TUInd clsInd = *(TUInd*)(currLongWatchPtr + 1);
+			// Fetching the clause (without reading its header, if the clause information is inlined in the watch)
+			const TWLClsRef clsRef = *(TWLClsRef*)(currLongWatchPtr + 1);
+			const TUInd clsInd = WLClsInd(clsRef);
 
-			auto cls = Cls(clsInd);
+			auto cls = WLCls(clsRef);
 
 			assert(!ClsChunkDeleted(clsInd));
 			assert(Compress || clsInd >= m_FirstLearntClsInd || !ClsGetIsLearnt(clsInd));
@@ -281,8 +536,7 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			// Check the other watch			
 			if (isOtherWatchSatisfied)
 			{
-				const TUV otherWatchDecLevel = GetAssignedDecLevel(cls[1]);
-				if (otherWatchDecLevel <= lDecLevel)
+				if (!ChronoBt || GetAssignedDecLevel(cls[1]) <= lDecLevel)
 				{
 					// The decision level of the other watch is not higher than that of l, so, fortunately, no chance of a delayed implication					
 					// Continue to the next clause
@@ -291,17 +545,18 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			}
 
 			// Going over the rest of the clause (that is, skipping the watches) to find the best WL candidate to swap with l
-			auto bestWLCandIt = FindBestWLCand(cls, m_DecLevel);
+			// The only candidate of a ternary clause is its last literal
+			auto bestWLCandIt = cls.size() == 3 ? cls.begin() + 2 : FindBestWLCand(cls, m_DecLevel);
 			const TULit bestWLCandLit = *bestWLCandIt;
 			const bool bestWLCandAssigned = IsAssigned(bestWLCandLit);
 			const bool bestWLCandSatisfied = IsSatisfied(bestWLCandLit);
 			const bool bestWLUnassignedOrSatisfied = (!bestWLCandAssigned) | bestWLCandSatisfied;
 
-			if (bestWLUnassignedOrSatisfied || (lDecLevel < m_DecLevel && GetAssignedDecLevel(bestWLCandLit) > lDecLevel))
+			if (bestWLUnassignedOrSatisfied || (ChronoBt && lDecLevel < m_DecLevel && GetAssignedDecLevel(bestWLCandLit) > lDecLevel))
 			{
 				// If the candidate is unassigned, satisfied or has a greater decision level, swap it with the current watch
 				SwapCurrWatch(m_CurrentlyPropagatedLit, bestWLCandIt, clsInd, cls, currLongWatchInd, currLongWatchPtr, wi);
-				if (unlikely(IsUnrecoverable())) return TContradictionInfo();
+				if (unlikely(IsUnrecoverable())) return;
 
 				if (bestWLUnassignedOrSatisfied)
 				{
@@ -333,15 +588,15 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 					if (cls1DecLevel < GetAssignedDecLevel(*maxNonWLDecLevelIt))
 					{
 						SwapWatch(clsInd, true, maxNonWLDecLevelIt);
-						if (unlikely(IsUnrecoverable())) return TContradictionInfo();
+						if (unlikely(IsUnrecoverable())) return;
 						// The line below is required to support the (very rare) occasions of b's realloc actually moving b in WLAddLongWatch
 						currLongWatchPtr = m_W.get_ptr_no_assert(wi.m_WBInd) + (currLongWatchInd * TWatchInfo::BinsInLong);
 					}
 				}
 
-				stopPropagating = NewContradiction(clsInd);
+				stopPropagating = BCPNewContradiction(clsInd);
 			}
-			else if (IsFalsified(cls[0]) && IsSatisfied(cls[1]) && GetAssignedDecLevel(cls[1]) > GetAssignedDecLevel(cls[0]))
+			else if (ChronoBt && IsFalsified(cls[0]) && IsSatisfied(cls[1]) && GetAssignedDecLevel(cls[1]) > GetAssignedDecLevel(cls[0]))
 				// Note that it is possible that the other watch is satisfied, the other watch's dl is greater than that of l,
 				// but it's not a delayed implication any longer, since we swapped cls[0] with another falsified literal having a higher decision level			
 			{
@@ -373,6 +628,35 @@ CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::B
 			}
 		}
 	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+CTopi<TLit, TUInd, Compress>::TContradictionInfo CTopi<TLit, TUInd, Compress>::BCP()
+{
+	// Returns true iff BCP should stop propagating the current literal
+	assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
+	assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
+
+	// assert(m_ParamAssertConsistency < 2 ||  P("DEBUG: " + SLits(GetCls(5304)) + "\n"));
+	CApplyFuncOnExitFromScope<> onExit([&]()
+	{
+		// The trail is kept compact outside BCP
+		TrailCompact();
+		ToPropagateClear();
+		CleanVisited();
+		m_CurrentlyPropagatedLit = BadULit;
+		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
+		assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(m_Cis.empty()));
+		m_Cis.clear();
+	});
+
+	++m_Stat.m_BCPs;
+
+	assert(NV(2) || P("***** BCP started; #" + to_string(m_Stat.m_BCPs) + "\n"));
+
+	assert(m_BCPKernel != nullptr);
+	(this->*m_BCPKernel)();
+	if (unlikely(IsUnrecoverable())) return TContradictionInfo();
 
 	if (m_Cis.empty())
 	{
@@ -415,6 +699,8 @@ bool CTopi<TLit, TUInd, Compress>::ProcessDelayedImplication(TULit diL, TULit ot
 	unordered_set<TUV> decLevelsRecalcBestScore;
 	const auto initDl = m_DecLevel;
 	auto& b = m_W;
+	// Breadth-first BCP should propagate the literals, whose decision level is about to be lowered, first
+	m_ToPropagateSortByDecLevel = true;
 	m_CurrPropWatchModifiedDuringProcessDelayedImplication = false;
 	[[maybe_unused]] auto decLevelStart = m_DecLevel;
 	// m_CurrentlyPropagatedLit can be BadULit only if the delayed implication emerged in a user-added clause
@@ -434,7 +720,7 @@ bool CTopi<TLit, TUInd, Compress>::ProcessDelayedImplication(TULit diL, TULit ot
 		//assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
 		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
 		m_Dis.clear();
-		assert(decLevelStart == m_DecLevel || GetAssignedDecLevelVar(m_TrailEnd) != decLevelStart);
+		assert(decLevelStart == m_DecLevel || TrailDecLevelIsEmpty(decLevelStart));
 		if (m_CurrCustomBtStrat > 0 && !decLevelsRecalcBestScore.empty())
 		{
 			for (TUV dl : decLevelsRecalcBestScore)
@@ -543,9 +829,9 @@ bool CTopi<TLit, TUInd, Compress>::ProcessDelayedImplication(TULit diL, TULit ot
 		for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, b.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 		{
 			TULit cachedLit = *currLongWatchPtr;
-			const TUInd clsInd = *(TUInd*)(currLongWatchPtr + 1);
+			const TUInd clsInd = WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1));
 			
-			assert(NV(2) || P("ProcessDelayedImplication: visiting long clause " + HexStr(*(TUInd*)(currLongWatchPtr + 1)) + ": cached " + SLit(cachedLit) + "; clause: " + SLits(Cls(*(TUInd*)(currLongWatchPtr + 1))) + "\n"));
+			assert(NV(2) || P("ProcessDelayedImplication: visiting long clause " + HexStr(clsInd) + ": cached " + SLit(cachedLit) + "; clause: " + SLits(Cls(clsInd)) + "\n"));
 			
 			// Some extra-care must be taken if the literal hasn't been fully propagated
 			// There might be a satisfied literal, which is not yet cached
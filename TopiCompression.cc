@@ -16,12 +16,19 @@ void CTopi<TLit, TUInd, Compress>::ReserveVarAndLitData(size_t maxAssumps)
 	// (2) the current decision level (which might still be greater than GetNextVar() + maxAssumps because of the previous call with potentially more assumptions)
 	const auto perDecLevelAlloc = std::max((size_t)GetNextVar() + (size_t)maxAssumps, (size_t)m_DecLevel) + 1;
 	ReserveExactly(m_Watches, GetNextLit(), 0, "m_Watches in ReserveVarAndLitData");
-	ReserveExactly(m_AssignmentInfo, GetNextVar(), 0, "m_AssignmentInfo in ReserveVarAndLitData");
+	ReserveExactly(m_AssignmentInfo, AssignmentInfoCap(GetNextVar()), 0, "m_AssignmentInfo in ReserveVarAndLitData");
+	// The padding might still hold the information of variables removed by the compression, which mustn't be inherited by the next new variables
+	if (!IsUnrecoverable() && m_AssignmentInfo.cap() > GetNextVar()) m_AssignmentInfo.memset(0, GetNextVar());
 	if (m_PolarityInfoActivated) ReserveExactly(m_PolarityInfo, GetNextVar(), 0, "m_PolarityInfo in ReserveVarAndLitData");
+	if (IsPhaseTargetOrBestOn()) ReserveExactly(m_PhaseSavedInfo, GetNextVar(), 0, "m_PhaseSavedInfo in ReserveVarAndLitData");
 	ReserveExactly(m_VarInfo, GetNextVar(), 0, "m_VarInfo in ReserveVarAndLitData");
 	ReserveExactly(m_ToPropagate, GetNextVar(), "m_ToPropagate in ReserveVarAndLitData");
-	ReserveExactly(m_TrailLastVarPerDecLevel, perDecLevelAlloc, BadUVar, "m_TrailLastVarPerDecLevel in ReserveVarAndLitData");
+	ReserveExactly(m_Trail, GetNextVar(), "m_Trail in ReserveVarAndLitData");
+	ReserveExactly(m_TrailDecLevelStart, perDecLevelAlloc, 0, "m_TrailDecLevelStart in ReserveVarAndLitData");
+	ReserveExactly(m_TrailCompactBuffer, GetNextVar(), "m_TrailCompactBuffer in ReserveVarAndLitData");
 	ReserveExactly(m_VsidsHeap, GetNextVar(), "m_VsidsHeap in ReserveVarAndLitData");
+	ReserveExactly(m_Vmtf, GetNextVar(), "m_Vmtf in ReserveVarAndLitData");
+	if (IsLrbUsed()) ReserveExactly(m_LrbInfo, GetNextVar(), 0, "m_LrbInfo in ReserveVarAndLitData");
 	ReserveExactly(m_HandyLitsClearBefore[0], GetNextVar(), "m_HandyLitsCleanBefore[0] in ReserveVarAndLitData");
 	if (m_ParamFlippedRecordingMaxLbdToRecord != 0) ReserveExactly(m_HandyLitsClearBefore[1], GetNextVar(), "m_HandyLitsCleanBefore[1] in ReserveVarAndLitData");
 	ReserveExactly(m_VisitedVars, GetNextVar(), "m_VisitedVars in ReserveVarAndLitData");
@@ -46,6 +53,7 @@ void CTopi<TLit, TUInd, Compress>::RemoveVarAndLitData(TUVar v)
 			MarkWatchBufferChunkDeleted(wi);
 		}
 	}
+	m_Vmtf.remove(v);
 }
 
 template <typename TLit, typename TUInd, bool Compress>
@@ -58,39 +66,19 @@ void CTopi<TLit, TUInd, Compress>::MoveVarAndLitData(TUVar vFrom, TUVar vTo)
 	m_Watches[GetLit(vTo, true)] = move(m_Watches[GetLit(vFrom, true)]);
 	m_AssignmentInfo[vTo] = move(m_AssignmentInfo[vFrom]);
 	if (m_PolarityInfoActivated) m_PolarityInfo[vTo] = move(m_PolarityInfo[vFrom]);
+	if (IsPhaseTargetOrBestOn()) m_PhaseSavedInfo[vTo] = move(m_PhaseSavedInfo[vFrom]);
+	if (IsLrbUsed()) m_LrbInfo[vTo] = move(m_LrbInfo[vFrom]);
 	m_VarInfo[vTo] = move(m_VarInfo[vFrom]);
 	if (IsAssignedVar(vFrom))
 	{
-		if (m_VarInfo[vTo].m_TrailPrev != BadUVar)
-		{
-			m_VarInfo[m_VarInfo[vTo].m_TrailPrev].m_TrailNext = vTo;
-		}
-
-		if (m_VarInfo[vTo].m_TrailNext != BadUVar)
-		{
-			m_VarInfo[m_VarInfo[vTo].m_TrailNext].m_TrailPrev = vTo;
-		}
-
-		if (m_TrailStart == vFrom)
-		{
-			m_TrailStart = vTo;
-		}
-
-		if (m_TrailEnd == vFrom)
-		{
-			m_TrailEnd = vTo;
-		}
-
-		if (m_TrailLastVarPerDecLevel[GetAssignedDecLevelVar(vFrom)] == vFrom)
-		{
-			m_TrailLastVarPerDecLevel[GetAssignedDecLevelVar(vFrom)] = vTo;
-		}
+		m_Trail[m_VarInfo[vTo].m_TrailPos] = vTo;
 	}
 
 	assert(m_ToPropagate.empty());
 
 	// Will have to replace in heap later!
 	m_VsidsHeap.replace_pos_score_vars(vFrom, vTo);
+	m_Vmtf.replace_vars(vFrom, vTo);
 
 	if (UseI2ELitMap()) m_I2ELitMap[vTo] = move(m_I2ELitMap[vFrom]);
 }
@@ -115,6 +103,7 @@ template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit, TUInd, Compress>::DeleteBinaryCls(const span<TULit> binCls)
 {
 	assert(binCls.size() == 2);
+	SavedTrailInvalidate();
 	WLRemoveBinaryWatch(binCls[0], binCls[1]);
 	WLRemoveBinaryWatch(binCls[1], binCls[0]);
 	m_Stat.DeleteBinClauses(1);
@@ -166,6 +155,11 @@ void CTopi<TLit, TUInd, Compress>::ClsDelNewLearntOrGlueUpdate(TUInd clsInd, TUV
 
 		float currActivity = ClsGetActivity(clsInd);
 		currActivity += (float)m_ClsDelOneTierActivityIncrease;
+		if (m_ParamClsDelTiers)
+		{
+			// Usage tracking for the tiers
+			currActivity = ClsActivityWithUsed(currActivity, true);
+		}
 		ClsSetActivity(clsInd, currActivity);
 		if (currActivity > 1e20)
 		{
@@ -177,7 +171,7 @@ void CTopi<TLit, TUInd, Compress>::ClsDelNewLearntOrGlueUpdate(TUInd clsInd, TUV
 					continue;
 				}
 				const auto clsRescaledActivity = ClsGetActivity(clsIndLocal);
-				ClsSetActivity(clsIndLocal, clsRescaledActivity * 1e-20f);
+				ClsSetActivity(clsIndLocal, m_ParamClsDelTiers ? ClsActivityWithUsed(clsRescaledActivity * 1e-20f, ClsGetUsed(clsIndLocal)) : clsRescaledActivity * 1e-20f);
 			}
 
 			m_ClsDelOneTierActivityIncrease *= 1e-20;
@@ -190,6 +184,27 @@ void CTopi<TLit, TUInd, Compress>::ClsDelNewLearntOrGlueUpdate(TUInd clsInd, TUV
 	}
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::ClsDelTier2IfRequired()
+{
+	if (!m_ParamClsDelTiers || m_ParamClsDelStrategy == 0 || m_Stat.m_Conflicts < m_ClsDelTier2Next || IsUnrecoverable() || m_Status == TToporStatus::STATUS_USER_INTERRUPT)
+	{
+		return;
+	}
+
+	m_ClsDelTier2Next = m_Stat.m_Conflicts + m_ParamClsDelTier2Interval;
+
+	// A tier-2 clause, unused until the next tier-2 reduction, will be treated as local; the used flags of the local clauses don't matter, but are cleared too, 
+	// so that a local clause would have to be used again after its glue drops into tier-2
+	for (TUInd clsInd = ClsLoopFirst(true); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+	{
+		if (!ClsChunkDeleted(clsInd) && ClsGetIsLearnt(clsInd) && ClsGetGlue(clsInd) > m_ParamClsDelTier1Glue && ClsGetUsed(clsInd))
+		{
+			ClsSetUsed(clsInd, false);
+		}
+	}
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 {
@@ -228,7 +243,7 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 
 	static constexpr bool sizetGreaterThenActs = sizeof(size_t) > sizeof(decltype(m_Stat.m_ActiveLongLearntClss));
 	const size_t learntsSz = sizetGreaterThenActs || m_Stat.m_ActiveLongLearntClss < (decltype(m_Stat.m_ActiveLongLearntClss))numeric_limits<size_t>::max() ? (size_t)m_Stat.m_ActiveLongLearntClss : (decltype(m_Stat.m_ActiveLongLearntClss))numeric_limits<size_t>::max();
-	CVector<TUInd> learnts(learntsSz);
+	CVector<TClsDelCandidate> learnts(learntsSz);
 	if (learnts.uninitialized_or_erroneous())
 	{
 		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "CTopi<TLit,TUInd,Compress>::DeleteClausesIfRequired: couldn't allocate learnts");
@@ -237,7 +252,8 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 
 	size_t undeletableButNotTouched = 0;
 	// Mark parent clauses as skipped for this round
-	for (TUVar v = m_TrailStart; v != BadUVar; v = GetTrailNextVar(v))
+	TrailCompact();
+	for (TUVar v : m_Trail.get_span())
 	{
 		const auto& ai = m_AssignmentInfo[v];
 		const auto& vi = m_VarInfo[v];
@@ -266,11 +282,11 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 
 	for (TUInd clsInd = ClsLoopFirst(true); !ClsLoopCompleted(); clsInd = ClsLoopNext())
 	{
-		if (ClsChunkDeleted(clsInd) || !ClsGetIsLearnt(clsInd) || ClsGetGlue(clsInd) <= m_ClsDelInfo.m_GlueNeverDelete)
+		if (ClsChunkDeleted(clsInd) || !ClsGetIsLearnt(clsInd) || ClsGetGlue(clsInd) <= m_ClsDelInfo.m_GlueNeverDelete || ClsDelIsKeptByTier(clsInd))
 		{
 			if (!ClsChunkDeleted(clsInd) && ClsGetIsLearnt(clsInd))
 			{
-				assert(ClsGetGlue(clsInd) <= m_ClsDelInfo.m_GlueNeverDelete);
+				assert(ClsGetGlue(clsInd) <= m_ClsDelInfo.m_GlueNeverDelete || ClsDelIsKeptByTier(clsInd));
 				++undeletableButNotTouched;
 			}
 			continue;
@@ -282,33 +298,9 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 			continue;
 		}
 
-		learnts.push_back(clsInd);
-	}
-
-	auto learntsSpan = learnts.get_span();
-
-	if (m_ClsDelInfo.m_Clusters == 0)
-	{
-		sort(learntsSpan.begin(), learntsSpan.end(), [&](TUInd clsInd1, TUInd clsInd2)
-		{
-			return ClsGetActivity(clsInd1) < ClsGetActivity(clsInd2) ||
-				((ClsGetActivity(clsInd1) == ClsGetActivity(clsInd2)) && (ClsGetGlue(clsInd1) > ClsGetGlue(clsInd2)));
-		});
-	}
-	else
-	{
-		sort(learntsSpan.begin(), learntsSpan.end(), [&](TUInd clsInd1, TUInd clsInd2)
-		{
-			const array<TUV, 2> glues = { ClsGetGlue(clsInd1), ClsGetGlue(clsInd2) };
-			const array<uint8_t, 2> clusters = { m_ClsDelInfo.GetCluster(glues[0]), m_ClsDelInfo.GetCluster(glues[1]) };
-			if (clusters[0] != clusters[1])
-			{
-				return clusters[0] > clusters[1];
-			}
-
-			const array<float, 2> acts = { ClsGetActivity(clsInd1), ClsGetActivity(clsInd2) };
-			return acts[0] < acts[1] || (acts[0] == acts[1] && glues[0] > glues[1]);
-		});
+		// The key is built once per clause, so the selection below doesn't access the clause buffer
+		const TUV glue = ClsGetGlue(clsInd);
+		learnts.push_back(TClsDelCandidate{ ClsDelKey(m_ClsDelInfo.m_Clusters == 0 ? numeric_limits<uint8_t>::max() : m_ClsDelInfo.GetCluster(glue), ClsGetActivity(clsInd), glue), clsInd });
 	}
 
 	size_t iLastExcl = (decltype(iLastExcl))((float)(ClsDeletionTrigger() - undeletableButNotTouched) * m_ClsDelInfo.m_FracToDelete);
@@ -317,6 +309,13 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 		iLastExcl = learnts.size();
 	}
 
+	// Only the clauses to be deleted must be separated from the rest (rather than the whole array sorted)
+	auto learntsSpan = learnts.get_span();
+	if (iLastExcl < learnts.size())
+	{
+		nth_element(learntsSpan.begin(), learntsSpan.begin() + iLastExcl, learntsSpan.end());
+	}
+
 	if (m_ParamClsDelStrategy == 1)
 	{
 		m_ClsDelInfo.m_TriggerNext = ClsDeletionTrigger() + m_ClsDelInfo.m_TriggerInc;
@@ -334,14 +333,22 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 	{
 		const float nextChange = static_cast<float>((m_Stat.m_Conflicts / m_ClsDelInfo.m_CurrChange) + 1.0);
 		m_ClsDelInfo.m_CurrChange += m_ClsDelInfo.m_TriggerInc;
-		if (ClsGetGlue(learnts[iLastExcl >> 1]) <= m_ParamClsDelS2LowGlue)
+		if (!learnts.empty())
 		{
-			m_ClsDelInfo.m_CurrChange += m_ParamClsDelS2LowMediumIncValue;
-		}
+			// The median of the deleted clauses and the best clause, as if the candidates were sorted
+			if (iLastExcl > 1)
+			{
+				nth_element(learntsSpan.begin(), learntsSpan.begin() + (iLastExcl >> 1), learntsSpan.begin() + iLastExcl);
+			}
+			if (ClsGetGlue(learnts[iLastExcl >> 1].m_ClsInd) <= m_ParamClsDelS2LowGlue)
+			{
+				m_ClsDelInfo.m_CurrChange += m_ParamClsDelS2LowMediumIncValue;
+			}
 
-		if (ClsGetGlue(learnts.back()) <= m_ParamClsDelS2MediumGlue)
-		{
-			m_ClsDelInfo.m_CurrChange += m_ParamClsDelS2LowMediumIncValue;
+			if (ClsGetGlue(std::max_element(learntsSpan.begin() + (iLastExcl < learnts.size() ? iLastExcl : 0), learntsSpan.end())->m_ClsInd) <= m_ParamClsDelS2MediumGlue)
+			{
+				m_ClsDelInfo.m_CurrChange += m_ParamClsDelS2LowMediumIncValue;
+			}
 		}
 
 		const double triggerNext = (double)nextChange * (double)m_ClsDelInfo.m_CurrChange;
@@ -360,7 +367,7 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 
 	for (size_t i = 0; i < iLastExcl; ++i)
 	{
-		const TUInd clsInd = learnts[i];
+		const TUInd clsInd = learnts[i].m_ClsInd;
 		assert(!ClsChunkDeleted(clsInd));
 		assert(ClsGetIsLearnt(clsInd));
 
@@ -383,11 +390,16 @@ void CTopi<TLit, TUInd, Compress>::DeleteClausesIfRequired()
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 {
-	if (m_DecLevel > m_DecLevelOfLastAssignedAssumption || m_TrailLastVarPerDecLevel[0] == m_LastGloballySatisfiedLitAfterSimplify || m_ImplicationsTillNextSimplify > 0 || IsUnrecoverable() || m_Status == TToporStatus::STATUS_USER_INTERRUPT)
+	TrailCompact();
+
+	if (m_DecLevel > m_DecLevelOfLastAssignedAssumption || !IsSimplifyDue() || IsUnrecoverable() || m_Status == TToporStatus::STATUS_USER_INTERRUPT)
 	{
 		return;
 	}
 
+	SavedTrailInvalidate();
+	RecentLearntsClear();
+
 	assert(NV(1) || P("Simplification started\n"));
 	assert(NV(2) || P("The trail: " + STrail() + "\n"));
 
@@ -397,7 +409,8 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 	
 	CApplyFuncOnExitFromScope<> onExit([&]()
 	{
-		m_LastGloballySatisfiedLitAfterSimplify = m_TrailLastVarPerDecLevel[0];
+		TrailCompact();
+		m_LastGloballySatisfiedLitAfterSimplify = TrailLastVarAtDecLevel(0);
 		m_ImplicationsTillNextSimplify = (int64_t)m_Stat.GetActiveLongClsLen();
 		++m_Stat.m_Simplifies;
 		if constexpr (!Compress)
@@ -420,16 +433,16 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 
 	// We sift variable indices, if there are at least two globally assigned variables
 	// We need to always leave one globally assigned variable to be able to map external globally assigned variables to it
-	const bool siftVarIndices = m_TrailLastVarPerDecLevel[0] != BadUVar && GetTrailPrevVar(m_TrailLastVarPerDecLevel[0]) != BadUVar;
+	const bool siftVarIndices = TrailDecLevelEnd(0) >= 2;
 	TUVar newLastExistingVar = m_LastExistingVar;
 	TUVar globallySatifiedVarLowestIndex = BadUVar;
 
 	if (siftVarIndices)
 	{
 		// Visited will contain all the globally assigned variables
-		for (TUVar currV = m_TrailLastVarPerDecLevel[0]; currV != BadUVar; currV = GetTrailPrevVar(currV))
+		for (TUV trailPos = 0; trailPos < TrailDecLevelEnd(0); ++trailPos)
 		{
-			MarkVisitedVar(currV);
+			MarkVisitedVar(m_Trail[trailPos]);
 		}
 
 		// Sorting the visited, so that m_VisitedVars.back() would have the smallest globaly assigned variable index 
@@ -655,6 +668,7 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 			{
 				// Resizing our clause
 				ClsSetSize(clsInd, (TUV)cls.size() - globallyFalsifiedLitsNum);
+				WLRefreshInlinedClsInfo(clsInd);
 				// Renewing the span
 				cls.Update();
 				assert(NV(2) || P("\tAfter removing the globally falsified literals: " + SLits(cls) + "\n"));
@@ -805,8 +819,9 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 	// We also remove all the watches of the globally satisfied literals (that is, the remaining binary watches, since the long ones have already been removed),
 	// and mark the chunks as deleted
 	size_t binClssCountOnce(0), binClssCountTwice(0);
-	for (TUVar currV = m_TrailLastVarPerDecLevel[0]; currV != BadUVar; currV = GetTrailPrevVar(currV))
+	for (TUV trailPos = TrailDecLevelEnd(0); trailPos-- > 0;)
 	{
+		const TUVar currV = m_Trail[trailPos];
 		const TULit currL = GetAssignedLitForVar(currV);
 		TWatchInfo& wi = m_Watches[currL];
 		if (!wi.IsEmpty())
@@ -878,8 +893,9 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 	{
 		if (m_DecLevel > 0)
 		{
-			for (TUVar v = GetTrailNextVar(m_TrailLastVarPerDecLevel[0]); v != BadUVar; v = GetTrailNextVar(v))
+			for (TUV trailPos = TrailDecLevelEnd(0); trailPos < (TUV)m_Trail.size(); ++trailPos)
 			{
+				const TUVar v = m_Trail[trailPos];
 				assert(m_AssignmentInfo[v].m_IsAssigned);
 				if (m_AssignmentInfo[v].m_IsAssignedInBinary)
 				{
@@ -977,6 +993,8 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 			MoveVarAndLitData(m_LastExistingVar, vTo);
 		}
 	}
+	// Remove the holes left by the unassigned globally assigned variables
+	TrailCompact();
 
 	// Mark all the variables, whose watches (binary and cached lits in long) contain the sifted indices
 	for (TUVar vBefore = newLastExistingVar + 1; vBefore < m_HandyLitsClearBefore[0].cap(); ++vBefore)
@@ -1002,7 +1020,7 @@ void CTopi<TLit, TUInd, Compress>::SimplifyIfRequired()
 			}
 			for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 			{
-				const TUInd clsInd = *(TUInd*)(currLongWatchPtr + 1);
+				const TUInd clsInd = WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1));
 				const auto cls = ConstClsSpan(clsInd, 2);
 				assert(cls[0] == l || cls[1] == l);
 				const TULit secondLit = cls[cls[0] == l];
@@ -1135,7 +1153,7 @@ bool CTopi<TLit, TUInd, Compress>::DebugAssertWaste()
 		}
 	}
 
-	assert(m_BWasted == w);
+	assert(m_BWasted + m_BPadding == w);
 
 	return true;
 }
@@ -1226,6 +1244,9 @@ void CTopi<TLit, TUInd, Compress>::CompressBuffersIfRequired()
 		return;
 	}
 
+	SavedTrailInvalidate();
+	RecentLearntsClear();
+
 	assert(NV(1) || P("Compression started: wasted fraction is " + to_string((double)m_BWasted / (double)nextBitOverall) + " > " + to_string(m_ParamWastedFractionThrToDelete) + "\n"));
 	assert(NV(2) || P("The trail: " + STrail() + "\n"));
 
@@ -1269,10 +1290,13 @@ void CTopi<TLit, TUInd, Compress>::CompressBuffersIfRequired()
 	if constexpr (!Compress)
 	{
 		[[maybe_unused]] const auto nextBefore = m_BNext;
+		[[maybe_unused]] const auto paddingBefore = m_BPadding;
 
-		m_B.template RemoveGarbage<TUInd>(LitsInPage, m_BNext, [&](TUInd clsInd) { return ClsChunkDeleted(clsInd); }, [&](TUInd clsInd) { return ClsEnd(clsInd); }, NotifyAboutRemainingChunkMove);
+		m_BPadding = 0;
+		m_B.template RemoveGarbage<TUInd>(LitsInPage, m_BNext, [&](TUInd clsInd) { return ClsChunkDeleted(clsInd); }, [&](TUInd clsInd) { return ClsEnd(clsInd); }, NotifyAboutRemainingChunkMove,
+			WLClsIndAlignment, [&](TUInd bInd, TUInd padding) { BAddPadding(bInd, padding); });
 
-		assert(nextBefore - m_BWasted == m_BNext);
+		assert(nextBefore - m_BWasted - paddingBefore == m_BNext - m_BPadding);
 		m_BWasted = 0;
 		if (m_B.cap() > (size_t)((double)m_BNext * m_ParamMultClss))
 		{
@@ -1326,7 +1350,7 @@ void CTopi<TLit, TUInd, Compress>::CompressBuffersIfRequired()
 		TULit* watchArena = m_W.get_ptr(wi.m_WBInd);
 		auto indBeyondLongWatches = wi.GetLongEntries();
 		watchArena[indBeyondLongWatches++] = inlinedLit;
-		*(TUInd*)(watchArena + indBeyondLongWatches) = clsInd;
+		*(TWLClsRef*)(watchArena + indBeyondLongWatches) = WLClsRef(clsInd);
 		++wi.m_LongWatches;
 	};
 
@@ -1334,7 +1358,12 @@ void CTopi<TLit, TUInd, Compress>::CompressBuffersIfRequired()
 	for (TUInd clsInd = ClsLoopFirst(false); !ClsLoopCompleted(); clsInd = ClsLoopNext())
 	{
 		//assert(NV(2) || ClsChunkDeleted(clsInd) ? P("Chunk " + HexStr(clsInd) + " was deleted!\n") : P("Clause " + HexStr((TUInd)clsInd) + ": " + SLits(Cls(clsInd)) + "\n"));
-		assert(!ClsChunkDeleted(clsInd));
+		if (ClsChunkDeleted(clsInd))
+		{
+			// Only the alignment padding remains after compression
+			assert(WLCompact);
+			continue;
+		}
 		// Note that we cannot because of correctness (and also should not because of efficiency) use the standard
 		// WLAddLongWatch procedure, since the number of long watches doesn't change
 		AddLongWatchLocal(false, clsInd);
@@ -54,7 +54,7 @@ TUInd CTopi<TLit, TUInd, Compress>::AddClsToBufferAndWatch(const TSpanTULit cls,
 		auto PointFromWatches = [&](TUInd clsInd)
 		{
 			const array<TUInd, 2> clsIndPtrs = { LastWLEntry(cls[0]), LastWLEntry(cls[1]) };
-			*((TUInd*)(m_W.get_ptr() + clsIndPtrs[0])) = *((TUInd*)(m_W.get_ptr() + clsIndPtrs[1])) = clsInd;
+			*((TWLClsRef*)(m_W.get_ptr() + clsIndPtrs[0])) = *((TWLClsRef*)(m_W.get_ptr() + clsIndPtrs[1])) = WLClsRef(clsInd, (TUV)cls.size(), isLearntNotForDeletion);
 			return clsInd;
 		};
 
@@ -62,9 +62,11 @@ TUInd CTopi<TLit, TUInd, Compress>::AddClsToBufferAndWatch(const TSpanTULit cls,
 		{
 			const bool isOversized = isLearntNotForDeletion && cls.size() > ClsLearntMaxSizeWithGlue;
 
-			const TUInd newBNext = m_BNext + (TUInd)cls.size() + EClsLitsStartOffset(isLearntNotForDeletion, isOversized);
+			// The clause must start at an index, which can be referred to by the long watches
+			const TUInd padding = BAlignmentPadding(m_BNext);
+			const TUInd newBNext = m_BNext + padding + (TUInd)cls.size() + EClsLitsStartOffset(isLearntNotForDeletion, isOversized);
 
-			if (unlikely(newBNext < m_BNext))
+			if (unlikely(newBNext < m_BNext || m_BNext + padding > WLMaxClsInd()))
 			{
 				SetStatus(TToporStatus::STATUS_INDEX_TOO_NARROW, "AddClsToBufferAndWatch: too many literals in all the clauses combined");
 				return clsStart;
@@ -80,6 +82,12 @@ TUInd CTopi<TLit, TUInd, Compress>::AddClsToBufferAndWatch(const TSpanTULit cls,
 				}
 			}
 
+			if (padding != 0)
+			{
+				BAddPadding(m_BNext, padding);
+				m_BNext += padding;
+			}
+
 			// The clause will start at m_BNext; point to it correctly from both watches
 			clsStart = PointFromWatches(m_BNext);
 			// Order of setting the fields is important, since ClsSetSize depends on ClsSetSize and ClsSetGlue depends on both
@@ -173,6 +181,198 @@ void CTopi<TLit, TUInd, Compress>::MinimizeClauseBin(CVector<TULit>& cls)
 	assert(NV(2) || P("Minimize-clause-binary finish; " + (cls.size() == clsSizeBefore ? "couldn't minimize" : "minimized and saved " + to_string(clsSizeBefore - cls.size()) + " literals") + ": " + SLits(cls.get_const_span()) + "\n"));
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::ShrinkClause(CVector<TULit>& cls, bool binaryParentsOnly)
+{
+	[[maybe_unused]] const auto clsSizeBefore = cls.size();
+
+	assert(NV(2) || P("Shrink-clause start: " + SLits(cls.get_const_span()) + "\n"));
+
+	assert(m_RootedVars.empty());
+
+	CApplyFuncOnExitFromScope<> onExit([&]()
+	{
+		CleanRooted();
+	});
+
+	// Make the literals of every decision level adjacent
+	auto clsSpan = cls.get_span();
+	sort(clsSpan.begin(), clsSpan.end(), [&](TULit l1, TULit l2) { return GetAssignedDecLevel(l1) > GetAssignedDecLevel(l2); });
+
+	// The rooted variables are the ones implied by the (shrunk) clause
+	m_RootedVars.reserve_exactly(cls.size());
+	if (unlikely(IsUnrecoverable())) return;
+
+	for (auto l : clsSpan)
+	{
+		MarkRooted(l);
+	}
+
+	// The shrunk clause is built in-place
+	size_t newSize = 0;
+	for (size_t levelStart = 0, levelEnd = 0; levelStart < cls.size(); levelStart = levelEnd)
+	{
+		const TUV decLevel = GetAssignedDecLevel(cls[levelStart]);
+		for (levelEnd = levelStart + 1; levelEnd < cls.size() && GetAssignedDecLevel(cls[levelEnd]) == decLevel; ++levelEnd);
+
+		TULit uipNegated = BadULit;
+		if (levelEnd - levelStart > 1)
+		{
+			const size_t rootedBefore = m_RootedVars.size();
+			// The number of the rooted variables of the current level, not visited yet by the walk over the trail
+			size_t unvisitedNum = levelEnd - levelStart;
+			bool canBeShrunk = true;
+
+			for (TUV vPos = TrailDecLevelEnd(decLevel); canBeShrunk && uipNegated == BadULit; )
+			{
+				if (vPos == TrailDecLevelStart(decLevel))
+				{
+					// Some of the rooted variables of the level are out of the sorted part of the trail
+					canBeShrunk = false;
+					break;
+				}
+
+				const TUVar v = m_Trail[--vPos];
+				if (!IsRootedVar(v))
+				{
+					continue;
+				}
+
+				if (--unvisitedNum == 0)
+				{
+					// Every rooted variable of the level is implied by v
+					uipNegated = Negate(GetAssignedLitForVar(v));
+					break;
+				}
+
+				if (IsAssignedDecVar(v) || (binaryParentsOnly && !m_AssignmentInfo[v].IsAssignedBinary()))
+				{
+					canBeShrunk = false;
+					break;
+				}
+
+				for (TULit parentLit : GetAssignedNonDecParentSpanVar(v))
+				{
+					const TUVar parentVar = GetVar(parentLit);
+					if (parentVar == v || IsRootedVar(parentVar) || GetAssignedDecLevelVar(parentVar) == 0)
+					{
+						continue;
+					}
+
+					if (GetAssignedDecLevelVar(parentVar) != decLevel)
+					{
+						// The parent contains a literal of another level, which doesn't appear in the clause
+						canBeShrunk = false;
+						break;
+					}
+
+					MarkRootedVar(parentVar);
+					if (unlikely(IsUnrecoverable())) return;
+					++unvisitedNum;
+				}
+			}
+
+			if (!canBeShrunk)
+			{
+				// The variables of the current level, visited by the walk, aren't implied by the clause
+				while (m_RootedVars.size() > rootedBefore)
+				{
+					RootedPopBack();
+				}
+			}
+		}
+
+		if (uipNegated != BadULit)
+		{
+			m_Stat.m_LitsRemovedByShrinking += levelEnd - levelStart - 1;
+			cls[newSize++] = uipNegated;
+		}
+		else
+		{
+			for (size_t i = levelStart; i < levelEnd; ++i)
+			{
+				cls[newSize++] = cls[i];
+			}
+		}
+	}
+
+	cls.resize(newSize);
+
+	assert(NV(2) || P("Shrink-clause finish; " + (cls.size() == clsSizeBefore ? "couldn't shrink" : "shrunk and saved " + to_string(clsSizeBefore - cls.size()) + " literals") + ": " + SLits(cls.get_const_span()) + "\n"));
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::EagerSubsumeRecentLearnts(const span<TULit> cls, TUInd clsInd)
+{
+	assert(m_RootedVars.empty());
+	assert(all_of(cls.begin(), cls.end(), [&](TULit l) { return IsFalsified(l); }));
+
+	CApplyFuncOnExitFromScope<> onExit([&]()
+	{
+		CleanRooted();
+	});
+
+	m_RootedVars.reserve_exactly(cls.size());
+	if (unlikely(IsUnrecoverable())) return;
+
+	for (auto l : cls)
+	{
+		MarkRooted(l);
+	}
+
+	// Since all the literals of the new clause are falsified, a literal of a recent clause belongs to the new clause iff it is falsified and its variable is rooted
+	for (TUInd& recentClsInd : m_RecentLearnts.get_span())
+	{
+		if (recentClsInd == BadClsInd || recentClsInd == clsInd || ClsGetSize(recentClsInd) < cls.size() || !ClsGetIsLearnt(recentClsInd))
+		{
+			continue;
+		}
+
+		size_t litsInCls = 0;
+		bool isParent = false;
+		for (TULit l : Cls(recentClsInd))
+		{
+			if (IsFalsified(l))
+			{
+				litsInCls += IsRooted(l);
+			}
+			else if (IsSatisfied(l) && !m_AssignmentInfo[GetVar(l)].IsAssignedBinary() && m_VarInfo[GetVar(l)].m_ParentClsInd == recentClsInd)
+			{
+				// The clause is the parent of an assigned variable
+				isParent = true;
+				break;
+			}
+		}
+
+		// The clause might still be required by on-the-fly subsumption
+		if (litsInCls == cls.size() && !isParent && none_of(m_VarsParentSubsumed.begin(), m_VarsParentSubsumed.end(), [&](const TParentSubsumed& vps) { return !vps.m_IsBinary && vps.m_ParentClsInd == recentClsInd; }))
+		{
+			assert(NV(2) || P("Eager subsumption deleted the recent learnt clause " + SLits(Cls(recentClsInd)) + "\n"));
+			++m_Stat.m_LearntsEagerlySubsumed;
+			// DeleteCls sets recentClsInd to BadClsInd
+			DeleteCls(recentClsInd);
+		}
+	}
+
+	// Remember the new clause
+	if (m_RecentLearnts.size() < m_ParamEagerSubsumptionRecent)
+	{
+		m_RecentLearnts.push_back(clsInd);
+		if (unlikely(m_RecentLearnts.uninitialized_or_erroneous()))
+		{
+			SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "m_RecentLearnts.push_back allocation failure");
+		}
+	}
+	else
+	{
+		if (m_RecentLearntsNext >= m_RecentLearnts.size())
+		{
+			m_RecentLearntsNext = 0;
+		}
+		m_RecentLearnts[m_RecentLearntsNext++] = clsInd;
+	}
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 bool CTopi<TLit, TUInd, Compress>::GenerateAllUipClause(CVector<TULit>& cls)
 {
@@ -222,25 +422,28 @@ bool CTopi<TLit, TUInd, Compress>::GenerateAllUipClause(CVector<TULit>& cls)
 		CleanRooted();
 	});
 
-	auto [initMarkedDecLevelsCounter, decLevels] = GetDecLevelsAndMarkInHugeCounter(cls);
+	const auto initMarkedDecLevelsCounter = GetDecLevelsAndMarkInHugeCounter(cls);
 	if (unlikely(IsUnrecoverable())) return false;
+	const auto decLevels = m_HugeCounterDecLevelsInCls.get_const_span();
 
 	auto UnvisitedNum = [&](TUV decLevel)
 	{
 		return m_HugeCounterPerDecLevel[decLevel] <= initMarkedDecLevelsCounter ? 0 : m_HugeCounterPerDecLevel[decLevel] - initMarkedDecLevelsCounter;
 	};
 
-	while (!decLevels.empty())
+	for (size_t decLevelInd = 0; decLevelInd < decLevels.size(); ++decLevelInd)
 	{
-		const TUV decLevel = decLevels.top();
-		decLevels.pop();
+		const TUV decLevel = decLevels[decLevelInd];
+		// The number of the decision levels still to be handled
+		const size_t decLevelsLeft = decLevels.size() - decLevelInd - 1;
 
 		assert(UnvisitedNum(decLevel) >= 1);
 
 		assert(NV(2) || P("Decision level " + to_string(decLevel) + " : started with " + to_string(UnvisitedNum(decLevel)) + " unvisited variables\n"));
 
-		for (TUVar v = m_TrailLastVarPerDecLevel[decLevel]; UnvisitedNum(decLevel) > 0; v = m_VarInfo[v].m_TrailPrev)
+		for (TUV vPos = TrailDecLevelEnd(decLevel) - 1; UnvisitedNum(decLevel) > 0; --vPos)
 		{
+			const TUVar v = m_Trail[vPos];
 			if (IsRootedVar(v))
 			{
 				assert(NV(2) || P("New rooted variable " + SVar(v) + "\n"));
@@ -260,7 +463,7 @@ bool CTopi<TLit, TUInd, Compress>::GenerateAllUipClause(CVector<TULit>& cls)
 
 				auto CancelAllUipClauseGenerationIfRequired = [&]()
 				{
-					if (res.size() + decLevels.size() >= cls.size())
+					if (res.size() + decLevelsLeft >= cls.size())
 					{
 						assert(NV(2) || P("Canceled AllUIP clause generation sue to exceeding size\n"));
 						cancelAllUipClauseGeneration = true;
@@ -508,7 +711,7 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 			{
 				visitedNegLitsPrevDecLevels.push_back(IsSatisfied(l) ? Negate(l) : l);
 			}
-			UpdateScoreVar(v, m_ParamVarActivityUseMapleLevelBreaker ? 0.5 : 1.0);
+			UpdateScoreVarOnAnalysis(v, m_ParamVarActivityUseMapleLevelBreaker ? 0.5 : 1.0);
 		}
 
 	};
@@ -551,18 +754,19 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 
 	
 	// Used to maintain all the heuristics working if the contradicting clause manages to stay the 1UIP
-	TUVar trailEndBeforeOnTheFlySubsumption = m_TrailEnd;
+	TUVar trailEndBeforeOnTheFlySubsumption = TrailEndVar();
 
 	m_VarsParentSubsumed.clear();
 
-	TUVar v = m_TrailEnd;
+	TUV vPos = (TUV)m_Trail.size() - 1;
+	TUVar v = m_Trail[vPos];
 	const TUV vDecLevel = GetAssignedDecLevelVar(v);
 	const TUVar vDecVar = GetDecVar(vDecLevel);
 	const bool isAssumpLevel = IsAssumpVar(vDecVar);
 	// Removing a subsumed contradicting clause at assumption level might result in a correctness problem, 
 	// because the algorithm doesn't stop at first UIP, so it won't record the subsuming clause
 	bool contradictingIsLearnt = IsOnTheFlySubsumptionContradictingOn() && !isAssumpLevel;
-	for (; varsToVisitCurrDecLevel != 1 || (isAssumpLevel && !(IsSatisfiedAssump(v) && m_AssignmentInfo[v].m_Visit)); v = m_VarInfo[v].m_TrailPrev)	
+	for (; varsToVisitCurrDecLevel != 1 || (isAssumpLevel && !(IsSatisfiedAssump(v) && m_AssignmentInfo[v].m_Visit)); v = m_Trail[--vPos])	
 	{
 		auto& ai = m_AssignmentInfo[v];
 		auto& vi = m_VarInfo[v];
@@ -694,19 +898,21 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 							}
 						}
 
-						while (m_TrailEnd != v)
+						while (TrailEndVar() != v)
 						{
-							UnassignVar(m_TrailEnd);
+							UnassignVar(TrailEndVar());
 						}
-						UnassignVar(m_TrailEnd);
-						while (!IsVisitedVar(m_TrailEnd))
+						UnassignVar(v);
+						while (!IsVisitedVar(TrailEndVar()))
 						{
-							UnassignVar(m_TrailEnd);
+							UnassignVar(TrailEndVar());
 						}
 						if (m_CurrCustomBtStrat > 0)
 						{
-							m_BestScorePerDecLevel[GetAssignedDecLevelVar(m_TrailEnd)] = CalcMaxDecLevelScore(GetAssignedDecLevelVar(m_TrailEnd));
+							m_BestScorePerDecLevel[GetAssignedDecLevelVar(TrailEndVar())] = CalcMaxDecLevelScore(GetAssignedDecLevelVar(TrailEndVar()));
 						}
+						// Continue from the new trail end
+						vPos = (TUV)m_Trail.size();
 					}
 					else
 					{
@@ -738,8 +944,9 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 					}
 
 					TUV varsVisitedNum = 0;
-					for (TUVar u = m_VarInfo[v].m_TrailPrev; varsVisitedNum < varsToVisitCurrDecLevel; u = m_VarInfo[u].m_TrailPrev)
+					for (TUV uPos = vPos - 1; varsVisitedNum < varsToVisitCurrDecLevel; --uPos)
 					{
+						const TUVar u = m_Trail[uPos];
 						if (IsVisitedVar(u))
 						{
 							if (m_CurrClsCounters[u] != m_CurrClsCounter)
@@ -776,11 +983,18 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 		if (unlikely(IsUnrecoverable())) return make_pair(visitedNegLitsPrevDecLevels.get_span(), BadClsInd);
 	}
 
+	// Shrinking may introduce a literal, which doesn't appear in the contradicting clause, so it's not applied if the contradicting clause is to be replaced by the new one
+	if (const uint8_t shrinkMode = GetShrinkMode(); shrinkMode != 0 && !contradictingIsLearnt && visitedNegLitsPrevDecLevels.size() > 1)
+	{
+		ShrinkClause(visitedNegLitsPrevDecLevels, shrinkMode == 1);
+		if (unlikely(IsUnrecoverable())) return make_pair(visitedNegLitsPrevDecLevels.get_span(), BadClsInd);
+	}
+
 
 	// Find the first UIP
 	while (!m_AssignmentInfo[v].m_Visit)
 	{
-		v = m_VarInfo[v].m_TrailPrev;
+		v = m_Trail[--vPos];
 	}
 	const TULit firstUIPNegated = Negate(GetAssignedLitForVar(v));
 
@@ -876,7 +1090,8 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 
 	assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
 
-	if (m_ParamVarActivityUseMapleLevelBreaker)
+	// VMTF's re-bumping would move the variables to the front in the visiting order (they're all bumped by VmtfBumpVisitedVars below anyway)
+	if (m_ParamVarActivityUseMapleLevelBreaker && m_CurrDecisionStrat != DECISION_STRAT_VMTF)
 	{
 		const TUV secondHighestDecLevel = visitedNegLitsPrevDecLevels.size() <= 1 ? 0 : min(GetAssignedDecLevel(visitedNegLitsPrevDecLevels[0]), GetAssignedDecLevel(visitedNegLitsPrevDecLevels[1]));
 		TUV decLevelMinToUpdate = secondHighestDecLevel - m_ParamVarActivityMapleLevelBreakerDecrease;
@@ -893,9 +1108,16 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 		}
 	}
 
+	BumpReasonSideVars(visitedNegLitsPrevDecLevels.get_span());
+
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		VmtfBumpVisitedVars();
+	}
+
 	const bool updateGlue = visitedNegLitsPrevDecLevels.size() > 2 && !addInitCls;
 	const auto glue = updateGlue ? ClsGetGlue(clsStart) : 0;
-	assert(IsOnTheFlySubsumptionContradictingOn() || trailEndBeforeOnTheFlySubsumption == m_TrailEnd);
+	assert(IsOnTheFlySubsumptionContradictingOn() || trailEndBeforeOnTheFlySubsumption == TrailEndVar());
 	UpdateDecisionStrategyOnNewConflict(glue, GetVar(firstUIPNegated), trailEndBeforeOnTheFlySubsumption);
 
 	if (updateGlue)
@@ -921,10 +1143,10 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 	}
 
 	const TUVar flippedVar = GetVar(m_FlippedLit);
-	for (TUVar v = m_TrailEnd; v != flippedVar; v = m_VarInfo[v].m_TrailPrev)
+	for (TUV vPos = (TUV)m_Trail.size() - 1; m_Trail[vPos] != flippedVar; --vPos)
 	{
-		assert(v != BadUVar);
-		MarkRootedVar(v);
+		assert(m_Trail[vPos] != BadUVar);
+		MarkRootedVar(m_Trail[vPos]);
 	}
 	MarkRootedVar(flippedVar);
 
@@ -984,9 +1206,10 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 		return make_pair(visitedNegLitsPrevFlippedLevels.get_span(), BadClsInd);
 	}
 
-	TUVar v = m_TrailEnd;
+	TUV vPos = (TUV)m_Trail.size() - 1;
+	TUVar v = TrailEndVar();
 
-	for (; varsToVisitCurrFlippedLevel != 1; v = m_VarInfo[v].m_TrailPrev)
+	for (; varsToVisitCurrFlippedLevel != 1; v = m_Trail[--vPos])
 	{
 		auto& ai = m_AssignmentInfo[v];
 		auto& vi = m_VarInfo[v];
@@ -1009,7 +1232,7 @@ pair<typename CTopi<TLit, TUInd, Compress>::TSpanTULit, TUInd> CTopi<TLit, TUInd
 	// Find the first UIP w.r.t the flipped level
 	while (!m_AssignmentInfo[v].m_Visit)
 	{
-		v = m_VarInfo[v].m_TrailPrev;
+		v = m_Trail[--vPos];
 	}
 
 	if (m_ParamFlippedRecordDropIfSubsumed)
@@ -1200,9 +1423,9 @@ bool CTopi<TLit, TUInd, Compress>::CiIsLegal(TContradictionInfo& ci, bool assert
 }
 
 template <typename TLit, typename TUInd, bool Compress>
-pair<uint64_t, priority_queue<typename CTopi<TLit, TUInd, Compress>::TUV>> CTopi<TLit, TUInd, Compress>::GetDecLevelsAndMarkInHugeCounter(TSpanTULit cls)
+uint64_t CTopi<TLit, TUInd, Compress>::GetDecLevelsAndMarkInHugeCounter(TSpanTULit cls)
 {
-	priority_queue<TUV> decLevels;
+	m_HugeCounterDecLevelsInCls.clear();
 
 	if (m_HugeCounterPerDecLevel.cap() <= m_DecLevel)
 	{
@@ -1210,10 +1433,13 @@ pair<uint64_t, priority_queue<typename CTopi<TLit, TUInd, Compress>::TUV>> CTopi
 		if (m_HugeCounterPerDecLevel.uninitialized_or_erroneous())
 		{
 			SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "GetDecLevelsAndMarkInHugeCounter: allocation failed");
+			return 0;
 		}
 	}
 
 	const auto initMarkedDecLevelsCounter = m_HugeCounterDecLevels;
+	TUV minDecLevel = numeric_limits<TUV>::max();
+	TUV maxDecLevel = 0;
 
 	for (TULit l : cls)
 	{
@@ -1221,8 +1447,10 @@ pair<uint64_t, priority_queue<typename CTopi<TLit, TUInd, Compress>::TUV>> CTopi
 		const TUV decLevel = GetAssignedDecLevel(l);
 		if (m_HugeCounterPerDecLevel[decLevel] <= initMarkedDecLevelsCounter)
 		{
-			decLevels.push(decLevel);
+			m_HugeCounterDecLevelsInCls.push_back(decLevel);
 			m_HugeCounterPerDecLevel[decLevel] = initMarkedDecLevelsCounter + 1;
+			minDecLevel = min(minDecLevel, decLevel);
+			maxDecLevel = max(maxDecLevel, decLevel);
 		}
 		else
 		{
@@ -1235,7 +1463,36 @@ pair<uint64_t, priority_queue<typename CTopi<TLit, TUInd, Compress>::TUV>> CTopi
 		}
 	}
 
-	return make_pair(initMarkedDecLevelsCounter, decLevels);
+	if (unlikely(m_HugeCounterDecLevelsInCls.uninitialized_or_erroneous()))
+	{
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "GetDecLevelsAndMarkInHugeCounter: couldn't allocate the decision levels");
+		return 0;
+	}
+
+	// Order the decision levels from the greatest to the lowest: if the levels are dense in their range, 
+	// collect the marked ones by a linear scan over the range (bucketing), otherwise sort them
+	auto decLevels = m_HugeCounterDecLevelsInCls.get_span();
+	const size_t decLevelsNum = decLevels.size();
+	if (decLevelsNum > 1)
+	{
+		if ((size_t)(maxDecLevel - minDecLevel) < decLevelsNum * (size_t)bit_width(decLevelsNum))
+		{
+			size_t i = 0;
+			for (TUV decLevel = maxDecLevel; i < decLevelsNum; --decLevel)
+			{
+				if (m_HugeCounterPerDecLevel[decLevel] > initMarkedDecLevelsCounter)
+				{
+					decLevels[i++] = decLevel;
+				}
+			}
+		}
+		else
+		{
+			sort(decLevels.begin(), decLevels.end(), greater<TUV>());
+		}
+	}
+
+	return initMarkedDecLevelsCounter;
 }
 
 template <typename TLit, typename TUInd, bool Compress>
@@ -1262,6 +1519,10 @@ void CTopi<TLit, TUInd, Compress>::ConflictAnalysisLoop(TContradictionInfo& cont
 		assert(GetAssignedDecLevel(contradictingCls[0]) == GetAssignedDecLevel(contradictingCls[1]));
 
 		Backtrack(maxDecLevelInContradictingCls);
+		if (IsPhaseTargetOrBestOn())
+		{
+			PhaseUpdateTargetAndBest(TrailDecLevelStart(m_DecLevel));
+		}
 		CVector<TULit> clsBeforeAllUipOrEmptyIfAllUipFailed;
 		auto [cls, assertingClsInd] = LearnAndUpdateHeuristics(contradictionInfo, clsBeforeAllUipOrEmptyIfAllUipFailed);
 		//assert(m_ParamVerbosityLevel <= 2 || P("***** Learnt clause " + SLits(cls) + "\n"));
@@ -1305,12 +1566,23 @@ void CTopi<TLit, TUInd, Compress>::ConflictAnalysisLoop(TContradictionInfo& cont
 		if (cls.size() > 2)
 		{
 			++m_RstGlueAssertingGluedClss;
-			if (m_CurrRestartStrat == RESTART_STRAT_LBD)
+			if (m_CurrRestartStrat == RESTART_STRAT_LBD || m_CurrRestartStrat == RESTART_STRAT_MODES)
 			{
 				// Might be initial because of on-the-fly subsumption
 				RstNewAssertingGluedCls(ClsGetIsLearnt(assertingClsInd) ? ClsGetGlue(assertingClsInd) : GetGlueAndMarkCurrDecLevels(ConstClsSpan(assertingClsInd)));
 			}
 		}
+		else if (m_CurrRestartStrat == RESTART_STRAT_MODES)
+		{
+			// The glue of a unit or a binary asserting clause is its size
+			RstNewAssertingGluedCls((TUV)cls.size());
+		}
+
+		if (m_ParamEagerSubsumptionRecent != 0 && cls.size() > 2 && ClsGetIsLearnt(assertingClsInd))
+		{
+			EagerSubsumeRecentLearnts(cls, assertingClsInd);
+			if (unlikely(IsUnrecoverable())) return;
+		}
 
 		// Determine how to backtrack 		
 		const bool isChronoBt = m_EarliestFalsifiedAssump != BadULit || conflictAtAssumptionLevel || (m_ConfsSinceNewInv >= m_ParamConflictsToPostponeChrono && m_DecLevel - ncbBtLevel > m_CurrChronoBtIfHigher) || maxDecLevelInContradictingCls <= m_DecLevelOfLastAssignedAssumption;
@@ -1377,8 +1649,11 @@ void CTopi<TLit, TUInd, Compress>::MarkDecisionsInConeAsVisited(TULit triggering
 		return;
 	}
 
-	for (TUVar v = GetVar(triggeringLit); v != BadUVar && GetAssignedDecLevelVar(v) != 0; v = m_VarInfo[v].m_TrailPrev)
+	TrailCompact();
+
+	for (TUV vPos = m_VarInfo[GetVar(triggeringLit)].m_TrailPos + 1; vPos-- > 0 && GetAssignedDecLevelVar(m_Trail[vPos]) != 0;)
 	{
+		const TUVar v = m_Trail[vPos];
 		if (IsVisitedVar(v) && !IsAssignedDecVar(v))
 		{
 			const auto cls = GetAssignedNonDecParentSpanVar(v);
@@ -63,13 +63,23 @@ string CTopi<TLit, TUInd, Compress>::STrail()
 
 	ss << "Current trail (reversed):\n";
 
-	for (TUVar v = m_TrailEnd; v != BadUVar; v = m_VarInfo[v].m_TrailPrev)
+	for (TUV trailPos = (TUV)m_Trail.size(); trailPos-- > 0;)
 	{
+		const TUVar v = m_Trail[trailPos];
+		if (trailPos + 1 == m_TrailSortedEnd && !TrailIsCompact())
+		{
+			ss << "\t *** End of the ordered part *** ";
+		}
+		if (v == BadUVar)
+		{
+			ss << "\t *** A hole *** ";
+			continue;
+		}
 		TULit l = GetAssignedLitForVar(v);
 		ss << "\t";
 
 		[[maybe_unused]] const TUV vDecLevel = GetAssignedDecLevelVar(v);
-		[[maybe_unused]] const TUV prevDecLevel = m_VarInfo[v].m_TrailPrev == BadUVar ? numeric_limits<TUV>::max() : GetAssignedDecLevelVar(m_VarInfo[v].m_TrailPrev);
+		[[maybe_unused]] const TUV prevDecLevel = trailPos == 0 || m_Trail[trailPos - 1] == BadUVar ? numeric_limits<TUV>::max() : GetAssignedDecLevelVar(m_Trail[trailPos - 1]);
 
 		if (vDecLevel != prevDecLevel)
 		{
@@ -201,8 +211,12 @@ void CTopi<TLit, TUInd, Compress>::VerifyDebugModel()
 		//cout << "m_DebugModel[" << externalV << "] = " << m_DebugModel[externalV] << " : " << SLit(l) << endl;
 	}
 
-	for (TUVar v = m_TrailStart; v != BadUVar; v = m_VarInfo[v].m_TrailNext)
+	for (TUVar v : m_Trail.get_span())
 	{
+		if (v == BadUVar)
+		{
+			continue;
+		}
 		const TULit l = GetLit(v, false);
 		const uint8_t expectedVal = ExpectedVal(l);
 		if (expectedVal != -1)
@@ -13,6 +13,47 @@ CTopi<TLit, TUInd, Compress>::TULit CTopi<TLit,TUInd,Compress>::Decide()
 	// Maple uses DISTANCE for the first 50000 conflicts, then switches between VSIDS and LRB
 	// Cadical switches between VSIDS and VMTF
 	// Fiver uses CBH
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		assert(m_ParamAssertConsistency < 1 || m_Vmtf.queue_consistent([&](TUVar v) { return IsAssignedVar(v); }));
+		const TUVar v = m_Vmtf.next_unassigned([&](TUVar v) { return IsAssignedVar(v); });
+		if (v == BadUVar)
+		{
+			return BadULit;
+		}
+		++m_Stat.m_Decisions;
+		m_Stat.m_SumOfAllDecLevels += m_DecLevel;
+		return GetLit(v, GetNextPolarityIsNegated(v));
+	}
+
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
+	{
+		while (!m_VsidsHeap.empty())
+		{
+			const TUVar v = m_VsidsHeap.get_min();
+			if (IsAssignedVar(v))
+			{
+				m_VsidsHeap.remove_min();
+				continue;
+			}
+
+			// Apply the decay for the conflicts since the last update lazily, and re-check the top of the heap
+			auto& li = m_LrbInfo[v];
+			if (li.m_UpdatedConf != m_Stat.m_Conflicts)
+			{
+				m_VsidsHeap.update_score(v, m_VsidsHeap.get_var_score(v) * pow((double)m_ParamLrbDecay, (double)(m_Stat.m_Conflicts - li.m_UpdatedConf)));
+				li.m_UpdatedConf = m_Stat.m_Conflicts;
+				continue;
+			}
+
+			m_VsidsHeap.remove_min();
+			++m_Stat.m_Decisions;
+			m_Stat.m_SumOfAllDecLevels += m_DecLevel;
+			return GetLit(v, GetNextPolarityIsNegated(v));
+		}
+		return BadULit;
+	}
+
 	while (!m_VsidsHeap.empty())
 	{
 		TUVar v = m_VsidsHeap.remove_min();
@@ -56,7 +97,7 @@ template <typename TLit, typename TUInd, bool Compress>
 bool CTopi<TLit,TUInd,Compress>::GetNextPolarityIsNegated(TUVar v)
 {
 	assert(!IsAssignedVar(v));
-	auto res = IsNotForced(v) ? (m_ParamPolarityStrat == 1 ? (bool)(rand() % 2) : m_AssignmentInfo[v].m_IsNegated) : m_PolarityInfo[v].GetNextPolarityIsNegated();
+	auto res = IsNotForced(v) ? (m_ParamPolarityStrat == 1 ? (bool)(rand() % 2) : IsPhaseTargetOn() ? (bool)m_PhaseSavedInfo[v].m_TargetIsNegated : (bool)m_AssignmentInfo[v].m_IsNegated) : m_PolarityInfo[v].GetNextPolarityIsNegated();
 
 	if (m_ParamPolarityFlipFactor != 0)
 	{
@@ -92,10 +133,12 @@ void CTopi<TLit,TUInd,Compress>::UpdateDecisionStrategyOnNewConflict(TUV glueLea
 	if (m_ParamVarActivityGlueUpdate && glueLearnt != 0)
 	{
 		assert(fakeTrailEnd != lowestGlueUpdateVar);
-		for (TUVar v = fakeTrailEnd; v != BadUVar && m_VarInfo[v].m_TrailNext != lowestGlueUpdateVar; v = m_VarInfo[v].m_TrailPrev)
+		// The trail entries beyond the trail end still hold the variables unassigned by on-the-fly subsumption
+		for (TUV vPos = m_VarInfo[fakeTrailEnd].m_TrailPos + 1; vPos-- > m_VarInfo[lowestGlueUpdateVar].m_TrailPos;)
 		{
+			const TUVar v = m_Trail[vPos];
 			auto& ai = m_AssignmentInfo[v];
-			assert(ai.m_IsAssigned || fakeTrailEnd != m_TrailEnd);
+			assert(ai.m_IsAssigned || fakeTrailEnd != TrailEndVar());
 			auto& vi = m_VarInfo[v];
 
 			if (ai.m_Visit && (ai.IsAssignedBinary() || 
@@ -106,8 +149,70 @@ void CTopi<TLit,TUInd,Compress>::UpdateDecisionStrategyOnNewConflict(TUV glueLea
 		}
 	}
 
-	// Decay activity
-	m_VsidsHeap.var_inc_update(m_Stat.m_VarDecay);
+	// Decay activity (the VSIDS scores are frozen while VMTF or LRB is used, so the increment mustn't keep growing)
+	if (m_CurrDecisionStrat == DECISION_STRAT_VSIDS)
+	{
+		m_VsidsHeap.var_inc_update(m_Stat.m_VarDecay);
+	}
+	else if (m_CurrDecisionStrat == DECISION_STRAT_LRB && m_LrbStepSize > m_ParamLrbStepSizeMin)
+	{
+		m_LrbStepSize = max((double)m_ParamLrbStepSizeMin, m_LrbStepSize - m_ParamLrbStepSizeDec);
+	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::BumpReasonSideVars(const span<TULit> cls)
+{
+	if (m_ParamReasonSideBumpingMaxDepth == 0 || cls.size() > m_ParamReasonSideBumpingMaxClsSize)
+	{
+		return;
+	}
+
+	// The visited variables (that is, the ones bumped by conflict analysis and the ones bumped here) aren't bumped again
+	for (TULit l : cls)
+	{
+		MarkVisitedVar(GetVar(l));
+	}
+	if (unlikely(IsUnrecoverable())) return;
+
+	auto BumpParentVars = [&](TUVar v)
+	{
+		if (IsAssignedDecVar(v))
+		{
+			return;
+		}
+
+		for (TULit parentLit : GetAssignedNonDecParentSpanVar(v))
+		{
+			const TUVar parentVar = GetVar(parentLit);
+			if (!IsVisitedVar(parentVar) && GetAssignedDecLevelVar(parentVar) != 0)
+			{
+				MarkVisitedVar(parentVar);
+				// VMTF bumps the visited variables after the analysis
+				if (m_CurrDecisionStrat != DECISION_STRAT_VMTF)
+				{
+					UpdateScoreVar(parentVar);
+				}
+			}
+		}
+	};
+
+	// The variables, whose parents are visited at the current depth, are m_VisitedVars[frontierStart, frontierEnd)
+	// The first depth is special, since the clause's variables are scattered over m_VisitedVars
+	size_t frontierStart = m_VisitedVars.size();
+	for (size_t i = 1; i < cls.size(); ++i)
+	{
+		BumpParentVars(GetVar(cls[i]));
+	}
+	for (uint8_t depth = 1; depth < m_ParamReasonSideBumpingMaxDepth && !IsUnrecoverable(); ++depth)
+	{
+		const size_t frontierEnd = m_VisitedVars.size();
+		for (size_t i = frontierStart; i < frontierEnd; ++i)
+		{
+			BumpParentVars(m_VisitedVars[i]);
+		}
+		frontierStart = frontierEnd;
+	}
 }
 
 template <typename TLit, typename TUInd, bool Compress>
@@ -124,6 +229,10 @@ void CTopi<TLit,TUInd,Compress>::DecisionInit()
 		m_Stat.m_VarDecay = m_QueryCurr == TQueryType::QUERY_INIT ? m_ParamVarActivityIncDecay : m_ParamVarActivityIncDecayReinitVal;		
 	}	
 
+	// The mode switching restart strategy (initialized before) might be in charge of the decision heuristic
+	DecisionStratSet(IsRstModeDecisionStrat() ? (m_RstModeIsStable ? DECISION_STRAT_VSIDS : DECISION_STRAT_VMTF) :
+		m_QueryCurr == TQueryType::QUERY_INIT ? m_ParamDecisionStrategyInit : m_QueryCurr == TQueryType::QUERY_INC_SHORT ? m_ParamDecisionStrategyS : m_ParamDecisionStrategyN);
+
 	if (InitClssBoostScoreStratOn())
 	{
 		m_CurrInitClssBoostScoreMult = InitClssBoostScoreStratIsReversedOrder() ? m_ParamInitClssBoostMultLowest : m_ParamInitClssBoostMultHighest;
@@ -138,9 +247,120 @@ void CTopi<TLit,TUInd,Compress>::DecisionInit()
 	}
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::DecisionStratSet(uint8_t newDecisionStrat)
+{
+	if (newDecisionStrat == m_CurrDecisionStrat)
+	{
+		return;
+	}
+
+	if (newDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		// The cursor wasn't maintained while VSIDS or LRB was used
+		m_Vmtf.reset_search();
+	}
+
+	// LRB's scores are in [0, 1], while VSIDS's scores are in the units of the current bumping factor, hence the scores are rescaled at every switch between the two
+	double scoreFactor = 1.;
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
+	{
+		scoreFactor = m_Stat.m_VarActivityInc;
+	}
+	else if (newDecisionStrat == DECISION_STRAT_LRB)
+	{
+		if (m_LrbInfo.cap() < GetNextVar())
+		{
+			// The parameters might have been changed after the variable data was reserved
+			ReserveExactly(m_LrbInfo, GetNextVar(), 0, "m_LrbInfo in DecisionStratSet");
+			if (unlikely(IsUnrecoverable())) return;
+		}
+
+		for (auto& li : m_LrbInfo.get_span_cap())
+		{
+			li.m_AssignedConf = li.m_UpdatedConf = li.m_ParticipatedConf = m_Stat.m_Conflicts;
+			li.m_Participated = 0;
+		}
+		m_LrbStepSize = m_ParamLrbStepSizeInit;
+
+		const double maxScore = (double)m_VsidsHeap.get_max_score();
+		if (maxScore > 0.)
+		{
+			scoreFactor = 1. / maxScore;
+		}
+	}
+
+	if (scoreFactor != 1.)
+	{
+		m_VsidsHeap.scale_scores(scoreFactor);
+		if (m_CurrCustomBtStrat > 0 && m_BestScorePerDecLevel.cap() != 0)
+		{
+			for (TUV dl = 0; dl <= m_DecLevel && dl < m_BestScorePerDecLevel.cap(); ++dl)
+			{
+				m_BestScorePerDecLevel[dl] = CalcMaxDecLevelScore(dl);
+			}
+		}
+	}
+
+	m_CurrDecisionStrat = newDecisionStrat;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::UpdateScoreVarOnAnalysis(TUVar v, double mult)
+{
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
+	{
+		// The conflict counter was already incremented for the current conflict, while the variable was assigned before it, 
+		// so m_ParticipatedConf (initialized at the assignment) never equals the counter at the variable's first participation
+		auto& li = m_LrbInfo[v];
+		if (li.m_ParticipatedConf != m_Stat.m_Conflicts)
+		{
+			li.m_ParticipatedConf = m_Stat.m_Conflicts;
+			++li.m_Participated;
+		}
+		return;
+	}
+
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		// The variable is in m_VisitedVars, which is bumped in the order of the time-stamps after the analysis (see VmtfBumpVisitedVars)
+		return;
+	}
+
+	UpdateScoreVar(v, mult);
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::VmtfBumpVisitedVars()
+{
+	assert(m_CurrDecisionStrat == DECISION_STRAT_VMTF);
+	// Bumping in the visiting order would scramble the relative order of the visited variables in the queue, 
+	// so they're bumped in the order of their previous time-stamps, as in CaDiCaL
+	auto vvSpan = m_VisitedVars.get_span();
+	sort(vvSpan.begin(), vvSpan.end(), [&](TUVar v1, TUVar v2) { return m_Vmtf.stamp(v1) < m_Vmtf.stamp(v2); });
+	for (TUVar v : vvSpan)
+	{
+		m_Vmtf.bump(v, IsAssignedVar(v));
+	}
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit,TUInd,Compress>::UpdateScoreVar(TUVar v, double mult)
 {
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		// VMTF ignores the multiplier: every bump moves the variable to the front
+		m_Vmtf.bump(v, IsAssignedVar(v));
+		return;
+	}
+
+	if (m_CurrDecisionStrat == DECISION_STRAT_LRB)
+	{
+		// LRB's reward is computed at the unassignment from the number of the conflicts the variable participated in (see UpdateScoreVarOnAnalysis), 
+		// so the other bump sources don't apply
+		return;
+	}
+
 	const bool isRescaled = m_VsidsHeap.increase_score(v, mult);
 	if (m_CurrCustomBtStrat > 0)
 	{
@@ -148,7 +368,7 @@ void CTopi<TLit,TUInd,Compress>::UpdateScoreVar(TUVar v, double mult)
 		{
 			for (auto& s : m_BestScorePerDecLevel.get_span_cap())
 			{
-				s *= 1e-100;
+				s *= m_VsidsHeap.RescaleFactor;
 			}
 		}
 
@@ -9,13 +9,11 @@ using namespace std;
 
 
 template <typename TLit, typename TUInd, bool Compress>
-void CTopi<TLit, TUInd, Compress>::IngRemoveBinaryWatchesIfRequired()
+uint64_t CTopi<TLit, TUInd, Compress>::IngRemoveDuplicateBinWatches(uint64_t)
 {
-	// Remove duplicate binary watches, if any are there and not handled on-the-fly
-	if (m_ParamExistingBinWLStrat <= 2 || m_IngLastEverAddedBinaryClss >= m_Stat.m_EverAddedBinaryClss)
-	{
-		return;
-	}
+	// Remove duplicate binary watches; applicable, if any are there and not handled on-the-fly
+	assert(m_ParamExistingBinWLStrat > 2 && m_IngLastEverAddedBinaryClss < m_Stat.m_EverAddedBinaryClss);
+	const auto duplicateBinsRemovedBefore = m_Stat.m_IngsDuplicateBinsRemoved;
 
 	auto RemoveDuplicateBinWatches = [&](TULit l)
 	{
@@ -59,33 +57,1284 @@ void CTopi<TLit, TUInd, Compress>::IngRemoveBinaryWatchesIfRequired()
 	}
 
 	m_IngLastEverAddedBinaryClss = m_Stat.m_EverAddedBinaryClss;
+	return m_Stat.m_IngsDuplicateBinsRemoved - duplicateBinsRemovedBefore;
 }
 
 template <typename TLit, typename TUInd, bool Compress>
-void CTopi<TLit, TUInd, Compress>::InprocessIfRequired()
-{	
-	// If postpone threshold m_ParamIngPostponeFirstInvConflicts not reached --> exit
-	// If postpone threshold reached, but no inprocessing invocations so far --> inprocess ASAP
-	//		Assertion: if inprocessing invoked at least once --> the postpone threashold must have been reached
-	assert(m_Stat.m_Ings == 0 || m_Stat.m_Conflicts >= m_ParamIngPostponeFirstInvConflicts);
-	// Once inprocessing invoked at least once (m_Stat.m_Ings > 0), if the # conflicts since the last inprocessing < m_ParamIngConflictsBeforeNextInvocation,
-	// wait, unless we must invoke after every query (m_ParamIngInvokeEveryQueryAfterInitPostpone) and we haven't invoked for this query yet (m_IngLastSolveInv < m_Stat.m_SolveInvs)
-	if (!m_ParamInprocessingOn || IsUnrecoverable() || m_Status == TToporStatus::STATUS_USER_INTERRUPT || m_DecLevel != m_DecLevelOfLastAssignedAssumption ||
-		(m_Stat.m_Conflicts < m_ParamIngPostponeFirstInvConflicts) ||
-		(m_Stat.m_Ings > 0 && ((m_Stat.m_Conflicts - m_IngLastConflicts) < m_ParamIngConflictsBeforeNextInvocation) && 
-			!(m_ParamIngInvokeEveryQueryAfterInitPostpone && m_IngLastSolveInv < m_Stat.m_SolveInvs)))
+uint64_t CTopi<TLit, TUInd, Compress>::IngVivify(uint64_t implicationsBudget)
+{
+	// Vivification is only sound w.r.t the formula (rather than the assumptions) at decision level 0
+	assert(m_ParamIngVivify && m_DecLevel == 0);
+
+	assert(NV(1) || P("Vivification started\n"));
+
+	const uint64_t removedBefore = m_Stat.m_IngsVivifyLitsRemoved + m_Stat.m_IngsVivifyClssDeleted;
+
+	CApplyFuncOnExitFromScope<> onExit([&]()
 	{
-		return;
+		// Backtracking from the vivification levels might have saved a trail, which isn't relevant to the search
+		SavedTrailInvalidate();
+		assert(NV(1) || P("Vivification finished\n"));
+		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || TrailAssertConsistency());
+		assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || WLAssertConsistency(false));
+	});
+
+	// The candidates are vivified in the ascending order of glue, then descending order of activity: 
+	// ClsDelKey, given the (saturated) glue as the cluster, provides exactly the reverse order
+	CVector<TClsDelCandidate> candidates;
+	for (TUInd clsInd = ClsLoopFirst(true); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+	{
+		if (ClsChunkDeleted(clsInd) || !ClsGetIsLearnt(clsInd))
+		{
+			continue;
+		}
+
+		const TUV glue = ClsGetGlue(clsInd);
+		if (glue <= m_ParamIngVivifyMaxGlue)
+		{
+			candidates.push_back(TClsDelCandidate{ ClsDelKey((uint8_t)min(glue, (TUV)numeric_limits<uint8_t>::max()), ClsGetActivity(clsInd), glue), clsInd });
+			if (unlikely(candidates.uninitialized_or_erroneous()))
+			{
+				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "IngVivify: couldn't allocate the candidates");
+				return 0;
+			}
+		}
 	}
 
-	++m_Stat.m_Ings;
-	m_IngLastSolveInv = m_Stat.m_SolveInvs;
-	m_IngLastConflicts = m_Stat.m_Conflicts;
-	
+	auto candidatesSpan = candidates.get_span();
+	sort(candidatesSpan.begin(), candidatesSpan.end(), [&](const TClsDelCandidate& c1, const TClsDelCandidate& c2) { return c2 < c1; });
 
-	assert(NV(1) || P("Inprocessing started for time " + to_string(m_Stat.m_Ings) + "; m_SolveInvs = " + to_string(m_IngLastSolveInv) + "; m_Conflicts = " + to_string(m_IngLastConflicts)));
+	const uint64_t implicationsEnd = m_Stat.m_Implications + implicationsBudget;
+
+	// The literals of the current candidate (copied, since the buffer may be reallocated by adding the vivified clause) and the vivified clause
+	CVector<TULit> clsLits;
+	CVector<TULit> vivifiedCls;
+
+	for (const TClsDelCandidate& candidate : candidatesSpan)
+	{
+		if (m_Stat.m_Implications >= implicationsEnd)
+		{
+			break;
+		}
+
+		const TUInd clsInd = candidate.m_ClsInd;
+		clsLits.clear();
+		clsLits.append(ConstClsSpan(clsInd));
+		vivifiedCls.clear();
+		if (vivifiedCls.cap() < clsLits.size())
+		{
+			vivifiedCls.reserve_atleast(clsLits.size());
+		}
+		if (unlikely(clsLits.uninitialized_or_erroneous() || vivifiedCls.uninitialized_or_erroneous()))
+		{
+			SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "IngVivify: couldn't allocate the clause");
+			return 0;
+		}
+
+		assert(NV(2) || P("Vivifying clause " + HexStr(clsInd) + ": " + SLits(clsLits.get_const_span()) + "\n"));
+
+		// Is the clause implied by the rest of the formula (that is, one of its literals is satisfied by propagating the negations of the others)?
+		bool isImplied = false;
+		for (TULit l : clsLits.get_const_span())
+		{
+			if (IsFalsified(l))
+			{
+				// Implied by the negations of the previous literals, hence redundant
+				continue;
+			}
+
+			vivifiedCls.push_back(l);
+
+			if (IsSatisfied(l))
+			{
+				// The clause itself is the parent, if all the other literals are falsified
+				const TUVar v = GetVar(l);
+				isImplied = m_AssignmentInfo[v].IsAssignedBinary() || m_VarInfo[v].m_ParentClsInd != clsInd;
+				break;
+			}
+
+			NewDecLevel();
+			[[maybe_unused]] const bool isContradictory = Assign(Negate(l), BadClsInd, BadULit, m_DecLevel);
+			assert(!isContradictory);
+			const TContradictionInfo ci = BCP();
+			if (unlikely(IsUnrecoverable())) return 0;
+			if (ci.IsContradiction())
+			{
+				// The rest of the literals are redundant
+				break;
+			}
+		}
+
+		if (isImplied)
+		{
+			assert(NV(2) || P("\tImplied by the rest of the formula -- deleting...\n"));
+			Backtrack(0);
+			++m_Stat.m_IngsVivifyClssDeleted;
+			DeleteCls(clsInd);
+		}
+		else if (vivifiedCls.size() < clsLits.size() && vivifiedCls.size() >= 2)
+		{
+			// A unit clause isn't recorded to keep decision level 0 intact (it'd require propagation, which may turn out contradictory)
+			assert(NV(2) || P("\tVivified to: " + SLits(vivifiedCls.get_const_span()) + "\n"));
+			const TUV glue = ClsGetGlue(clsInd);
+			const float activity = ClsGetActivity(clsInd);
+
+			// The new clause is added before backtracking, while all its literals are still assigned, for its glue to be calculated
+			const TUInd newClsInd = AddClsToBufferAndWatch(vivifiedCls.get_span(), true, true);
+			if (unlikely(IsUnrecoverable())) return 0;
+			if (newClsInd != BadClsInd)
+			{
+				ClsSetGlue(newClsInd, min(glue, ClsGetGlue(newClsInd)));
+				if (m_ParamClsDelStrategy > 0)
+				{
+					ClsSetActivity(newClsInd, activity);
+				}
+			}
+
+			Backtrack(0);
+			m_Stat.m_IngsVivifyLitsRemoved += clsLits.size() - vivifiedCls.size();
+			DeleteCls(clsInd);
+		}
+		else
+		{
+			Backtrack(0);
+		}
+	}
+
+	return m_Stat.m_IngsVivifyLitsRemoved + m_Stat.m_IngsVivifyClssDeleted - removedBefore;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+uint64_t CTopi<TLit, TUInd, Compress>::IngSubstituteEquivalences()
+{
+	// The substitution is sound w.r.t the formula only at decision level 0; 
+	// it's not applied, if the internal literals are exposed to the outside world, since the substituted variables are assigned arbitrarily internally
+	assert(m_DecLevel == 0 && !UseI2ELitMap());
+
+	auto BinWatches = [&](TULit l) { return m_Watches[l].m_BinaryWatches == 0 ? TSpanTULit() : TSpanTULit(m_W.get_ptr(m_Watches[l].m_WBInd) + m_Watches[l].GetLongEntries(), m_Watches[l].m_BinaryWatches); };
+
+	const size_t litsNum = GetNextLit();
+	// Literal --> its representative (the literal of the lowest variable in its strongly connected component); BadULit for assigned literals
+	vector<TULit> repr(litsNum, BadULit);
+
+	// Tarjan's algorithm over the unassigned literals, where the successors of l are the implications of the binary clauses (~l, l2), that is, the binary watches of ~l
+	{
+		// 0 stands for not visited yet
+		vector<uint32_t> indices(litsNum, 0);
+		vector<uint32_t> lowLinks(litsNum, 0);
+		vector<bool> isOnStack(litsNum, false);
+		vector<TULit> sccStack;
+		// The DFS stack: the literal and the index of its next successor
+		vector<pair<TULit, TUInd>> dfsStack;
+		uint32_t nextIndex = 1;
+
+		auto Visit = [&](TULit l)
+		{
+			indices[l] = lowLinks[l] = nextIndex++;
+			sccStack.push_back(l);
+			isOnStack[l] = true;
+			dfsStack.emplace_back(l, 0);
+		};
+
+		for (TULit root = GetLit(1, false); root < litsNum; ++root)
+		{
+			if (indices[root] != 0 || IsAssigned(root))
+			{
+				continue;
+			}
+
+			Visit(root);
+			while (!dfsStack.empty())
+			{
+				const TULit l = dfsStack.back().first;
+				const auto successors = BinWatches(Negate(l));
+				if (dfsStack.back().second < successors.size())
+				{
+					const TULit l2 = successors[dfsStack.back().second++];
+					if (IsAssigned(l2))
+					{
+						continue;
+					}
+					if (indices[l2] == 0)
+					{
+						Visit(l2);
+					}
+					else if (isOnStack[l2])
+					{
+						lowLinks[l] = min(lowLinks[l], indices[l2]);
+					}
+					continue;
+				}
+
+				dfsStack.pop_back();
+				if (!dfsStack.empty())
+				{
+					const TULit parent = dfsStack.back().first;
+					lowLinks[parent] = min(lowLinks[parent], lowLinks[l]);
+				}
+
+				if (lowLinks[l] == indices[l])
+				{
+					// l is the root of a strongly connected component, which is at the top of sccStack
+					const auto sccIt = find(sccStack.rbegin(), sccStack.rend(), l).base() - 1;
+					const TULit r = *min_element(sccIt, sccStack.end(), [&](TULit l1) { return GetVar(l1); });
+					for (auto it = sccIt; it != sccStack.end(); ++it)
+					{
+						isOnStack[*it] = false;
+						repr[*it] = r;
+					}
+
+					if (any_of(sccIt, sccStack.end(), [&](TULit l1) { return repr[Negate(l1)] == r; }))
+					{
+						SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: a literal is equivalent to its negation");
+						return 0;
+					}
+
+					sccStack.erase(sccIt, sccStack.end());
+				}
+			}
+		}
+	}
+
+	// The assumptions of the current query aren't substituted (their equivalent literals are substituted by them or by other representatives)
+	auto IsSubstituted = [&](TUVar v) { return repr[GetLit(v, false)] != BadULit && GetVar(repr[GetLit(v, false)]) != v && !IsAssumpVar(v); };
+	auto Subst = [&](TULit l) { return IsSubstituted(GetVar(l)) ? repr[l] : l; };
+
+	vector<TUVar> substVars;
+	for (TUVar v = 1; v < GetNextVar(); ++v)
+	{
+		if (IsSubstituted(v))
+		{
+			// The representative must be consistent for both the polarities
+			assert(repr[GetLit(v, true)] == Negate(repr[GetLit(v, false)]));
+			substVars.push_back(v);
+		}
+	}
+
+	if (substVars.empty())
+	{
+		return 0;
+	}
+
+	assert(NV(1) || P("Probing: substituting " + to_string(substVars.size()) + " variables by their equivalent literals\n"));
+
+	// The units, discovered by the substitution
+	vector<TULit> units;
+
+	// The long clauses: the irredundant clauses are rewritten, while the learnt clauses are deleted 
+	// (their glue can't be recalculated, since their literals are unassigned)
+	vector<TUInd> clssToRewrite;
+	for (TUInd clsInd = ClsLoopFirst(false); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+	{
+		if (!ClsChunkDeleted(clsInd))
+		{
+			auto cls = Cls(clsInd);
+			if (any_of(cls.begin(), cls.end(), [&](TULit l) { return IsSubstituted(GetVar(l)); }))
+			{
+				clssToRewrite.push_back(clsInd);
+			}
+		}
+	}
+
+	vector<TULit> newCls;
+	for (TUInd clsInd : clssToRewrite)
+	{
+		if (!ClsGetIsLearnt(clsInd))
+		{
+			newCls.clear();
+			bool isSatisfied = false;
+			for (TULit l : Cls(clsInd))
+			{
+				const TULit newLit = Subst(l);
+				if (IsSatisfied(newLit))
+				{
+					isSatisfied = true;
+					break;
+				}
+				if (!IsFalsified(newLit))
+				{
+					newCls.push_back(newLit);
+				}
+			}
+
+			if (!isSatisfied)
+			{
+				// Removing the duplicates and detecting the tautologies: l and ~l are adjacent after sorting
+				sort(newCls.begin(), newCls.end());
+				newCls.erase(unique(newCls.begin(), newCls.end()), newCls.end());
+				const bool isTautology = adjacent_find(newCls.begin(), newCls.end(), [&](TULit l1, TULit l2) { return l2 == Negate(l1); }) != newCls.end();
+
+				if (!isTautology)
+				{
+					assert(NV(2) || P("\tRewriting clause " + HexStr(clsInd) + ": " + SLits(Cls(clsInd)) + " to " + SLits(newCls) + "\n"));
+					if (newCls.empty())
+					{
+						SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by equivalent literal substitution");
+						return 0;
+					}
+					else if (newCls.size() == 1)
+					{
+						units.push_back(newCls[0]);
+					}
+					else
+					{
+						AddClsToBufferAndWatch(newCls, false, true);
+						if (unlikely(IsUnrecoverable())) return 0;
+					}
+				}
+			}
+		}
+		DeleteCls(clsInd);
+	}
+
+	// The binary clauses
+	for (TUVar v : substVars)
+	{
+		for (TULit l : { GetLit(v, false), GetLit(v, true) })
+		{
+			for (auto binWatches = BinWatches(l); !binWatches.empty(); binWatches = BinWatches(l))
+			{
+				array<TULit, 2> binCls = { l, binWatches.back() };
+				array<TULit, 2> newBinCls = { Subst(binCls[0]), Subst(binCls[1]) };
+				DeleteBinaryCls(binCls);
+
+				if (IsSatisfied(newBinCls[0]) || IsSatisfied(newBinCls[1]) || newBinCls[0] == Negate(newBinCls[1]))
+				{
+					continue;
+				}
+
+				if (IsFalsified(newBinCls[0]))
+				{
+					swap(newBinCls[0], newBinCls[1]);
+				}
+
+				if (IsFalsified(newBinCls[0]))
+				{
+					SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by equivalent literal substitution");
+					return 0;
+				}
+
+				if (newBinCls[0] == newBinCls[1] || IsFalsified(newBinCls[1]))
+				{
+					units.push_back(newBinCls[0]);
+				}
+				else
+				{
+					AddClsToBufferAndWatch(newBinCls, false, true);
+					if (unlikely(IsUnrecoverable())) return 0;
+				}
+			}
+			assert(m_Watches[l].IsEmpty() || m_Watches[l].GetUsedEntries() == 0);
+		}
+	}
+
+	for (TULit l : units)
+	{
+		if (!IsAssigned(l) && Assign(l, BadClsInd, BadULit, 0))
+		{
+			SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by equivalent literal substitution");
+			return 0;
+		}
+		if (IsFalsified(l))
+		{
+			SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by equivalent literal substitution");
+			return 0;
+		}
+	}
+
+	// The external variables are mapped to the representatives
+	auto e2iSpan = m_E2ILitMap.get_span_cap();
+	for (TULit& l : e2iSpan)
+	{
+		if (l != BadULit && (size_t)l < litsNum && IsSubstituted(GetVar(l)))
+		{
+			l = repr[l];
+		}
+	}
+
+	// The substituted variables don't appear in any clauses, so they're assigned at decision level 0 to be removed by the simplification, which is brought forward
+	for (TUVar v : substVars)
+	{
+		if (!IsAssignedVar(v))
+		{
+			Assign(GetLit(v, true), BadClsInd, BadULit, 0);
+		}
+	}
+	m_ImplicationsTillNextSimplify = 0;
+
+	const TContradictionInfo ci = BCP();
+	if (unlikely(IsUnrecoverable())) return 0;
+	if (ci.IsContradiction())
+	{
+		SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by BCP after equivalent literal substitution");
+		return 0;
+	}
+
+	m_Stat.m_IngsProbeEquivVars += substVars.size();
+	return substVars.size();
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+uint64_t CTopi<TLit, TUInd, Compress>::IngProbe(uint64_t implicationsBudget)
+{
+	// Probing is only sound w.r.t the formula (rather than the assumptions) at decision level 0
+	assert(m_ParamIngProbe && m_DecLevel == 0);
 
-	IngRemoveBinaryWatchesIfRequired();
+	assert(NV(1) || P("Probing started\n"));
+
+	const uint64_t removedBefore = m_Stat.m_IngsProbeFailedLits + m_Stat.m_IngsProbeEquivVars;
+
+	CApplyFuncOnExitFromScope<> onExit([&]()
+	{
+		// Backtracking from the probing level might have saved a trail, which isn't relevant to the search
+		SavedTrailInvalidate();
+		assert(NV(1) || P("Probing finished\n"));
+		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || IsUnrecoverable() || TrailAssertConsistency());
+		assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || IsUnrecoverable() || WLAssertConsistency(false));
+	});
+
+	try
+	{
+		if (m_ParamIngProbeEquivalences && !UseI2ELitMap())
+		{
+			IngSubstituteEquivalences();
+			if (unlikely(IsUnrecoverable())) return 0;
+		}
+	}
+	catch (...)
+	{
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "IngProbe: allocation failed");
+		return 0;
+	}
+
+	const uint64_t implicationsEnd = m_Stat.m_Implications + implicationsBudget;
+
+	// A root of the binary implication graph isn't implied by any binary clause (isn't a part of any binary clause), but implies other literals
+	auto IsRoot = [&](TULit l) { return m_Watches[l].m_BinaryWatches == 0 && m_Watches[Negate(l)].m_BinaryWatches != 0; };
+
+	for (TUVar v = 1; v < GetNextVar() && m_Stat.m_Implications < implicationsEnd; ++v)
+	{
+		for (TULit l : { GetLit(v, false), GetLit(v, true) })
+		{
+			if (IsAssignedVar(v) || !IsRoot(l))
+			{
+				continue;
+			}
+
+			NewDecLevel();
+			[[maybe_unused]] const bool isContradictory = Assign(l, BadClsInd, BadULit, m_DecLevel);
+			assert(!isContradictory);
+			TContradictionInfo ci = BCP();
+			if (unlikely(IsUnrecoverable())) return 0;
+			Backtrack(0);
+
+			if (ci.IsContradiction())
+			{
+				// A failed literal: its negation is implied by the formula
+				assert(NV(2) || P("\tFailed literal: " + SLit(l) + "\n"));
+				++m_Stat.m_IngsProbeFailedLits;
+				const TULit unit = Negate(l);
+				if (IsCbLearntOrDrat())
+				{
+					array<TULit, 1> unitCls = { unit };
+					NewLearntClsApplyCbLearntDrat(unitCls);
+				}
+
+				Assign(unit, BadClsInd, BadULit, 0);
+				ci = BCP();
+				if (unlikely(IsUnrecoverable())) return 0;
+				if (ci.IsContradiction())
+				{
+					SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by BCP after failed literal probing");
+					return 0;
+				}
+			}
+		}
+	}
+
+	return m_Stat.m_IngsProbeFailedLits + m_Stat.m_IngsProbeEquivVars - removedBefore;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+uint64_t CTopi<TLit, TUInd, Compress>::IngSubsume(uint64_t stepsBudget)
+{
+	// Subsumption is only sound w.r.t the formula (rather than the assumptions) at decision level 0
+	assert(m_ParamIngSubsume && m_DecLevel == 0);
+
+	assert(NV(1) || P("Subsumption started\n"));
+
+	const uint64_t removedBefore = m_Stat.m_IngsSubsumeClssDeleted + m_Stat.m_IngsSubsumeLitsRemoved;
+
+	CApplyFuncOnExitFromScope<> onExit([&]()
+	{
+		assert(NV(1) || P("Subsumption finished\n"));
+		assert(m_ParamAssertConsistency < 1 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || IsUnrecoverable() || TrailAssertConsistency());
+		assert(m_ParamAssertConsistency < 2 || m_Stat.m_Conflicts < (uint64_t)m_ParamAssertConsistencyStartConf || IsUnrecoverable() || WLAssertConsistency(false));
+	});
+
+	// A long clause, which is a candidate for being subsumed or strengthened (and, subsequently, for subsuming or strengthening other clauses)
+	struct TSubsumeCandidate
+	{
+		TUInd m_ClsInd;
+		// Bit (v % 64) is set for every variable v of the clause
+		uint64_t m_Signature;
+		TUV m_Size;
+		bool m_IsLearnt;
+	};
+
+	const uint64_t stepsEnd = m_IngSteps + stepsBudget;
+
+	try
+	{
+		auto Signature = [&](TUInd clsInd)
+		{
+			uint64_t signature = 0;
+			for (TULit l : Cls(clsInd))
+			{
+				signature |= (uint64_t)1 << (GetVar(l) & 63);
+			}
+			return signature;
+		};
+
+		// The candidates are the long clauses with no assigned literals (the rest are left to the simplification)
+		vector<TSubsumeCandidate> candidates;
+		for (TUInd clsInd = ClsLoopFirst(false); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+		{
+			if (ClsChunkDeleted(clsInd))
+			{
+				continue;
+			}
+
+			auto cls = Cls(clsInd);
+			if (any_of(cls.begin(), cls.end(), [&](TULit l) { return IsAssigned(l); }))
+			{
+				continue;
+			}
+
+			candidates.push_back(TSubsumeCandidate{ clsInd, Signature(clsInd), (TUV)cls.size(), ClsGetIsLearnt(clsInd) });
+		}
+
+		// Forward subsumption: every clause is checked against the shorter clauses (and the irredundant before the learnt ones of the same size), processed before it
+		sort(candidates.begin(), candidates.end(), [&](const TSubsumeCandidate& c1, const TSubsumeCandidate& c2)
+		{
+			return c1.m_Size < c2.m_Size || (c1.m_Size == c2.m_Size && !c1.m_IsLearnt && c2.m_IsLearnt);
+		});
+
+		// One-watch occurrence lists: every processed clause is referred to (by its candidate index) from the list of one of its literals only
+		vector<vector<size_t>> occs(GetNextLit());
+		// The literals of the currently processed clause
+		vector<uint8_t> litMarks(GetNextLit(), 0);
+
+		auto BinWatches = [&](TULit l) { return m_Watches[l].m_BinaryWatches == 0 ? TSpanTULit() : TSpanTULit(m_W.get_ptr(m_Watches[l].m_WBInd) + m_Watches[l].GetLongEntries(), m_Watches[l].m_BinaryWatches); };
+
+		// Does the clause subsume the marked clause, if up to one of its literals is flipped? 
+		// Returns <true, BadULit> for subsumption and <true, l> for strengthening, where l is the marked clause's literal to be removed
+		auto SubsumesMarked = [&](TUInd clsInd)
+		{
+			TULit flippedLit = BadULit;
+			for (TULit l : Cls(clsInd))
+			{
+				++m_IngSteps;
+				if (litMarks[l])
+				{
+					continue;
+				}
+				if (flippedLit == BadULit && litMarks[Negate(l)])
+				{
+					flippedLit = Negate(l);
+					continue;
+				}
+				return make_pair(false, BadULit);
+			}
+			return make_pair(true, flippedLit);
+		};
+
+		// The original literals of the currently processed clause (copied to be unmarked, since the clause may be modified or deleted)
+		vector<TULit> clsLits;
+
+		for (size_t candInd = 0; candInd < candidates.size() && m_IngSteps < stepsEnd; ++candInd)
+		{
+			TSubsumeCandidate& c = candidates[candInd];
+			clsLits.clear();
+			for (TULit l : Cls(c.m_ClsInd))
+			{
+				clsLits.push_back(l);
+				litMarks[l] = 1;
+			}
+
+			// Is the clause subsumed (or replaced by a binary clause)?
+			bool isRemoved = false;
+			// The clause is re-checked after every strengthening, since any modification invalidates the clause and the watches
+			for (bool isStrengthened = true; isStrengthened && !isRemoved; )
+			{
+				isStrengthened = false;
+				// The literal to remove from the clause, if it's strengthened
+				TULit removedLit = BadULit;
+				
+				for (TULit l : Cls(c.m_ClsInd))
+				{
+					// The binary clauses are never deleted, so they may subsume the irredundant clauses too
+					for (TULit otherLit : BinWatches(l))
+					{
+						++m_IngSteps;
+						if (litMarks[otherLit])
+						{
+							isRemoved = true;
+							break;
+						}
+						if (litMarks[Negate(otherLit)])
+						{
+							removedLit = Negate(otherLit);
+							break;
+						}
+					}
+
+					for (TULit occLit : { l, Negate(l) })
+					{
+						for (size_t occInd = 0; occInd < occs[occLit].size() && !isRemoved && removedLit == BadULit; ++occInd)
+						{
+							++m_IngSteps;
+							const TSubsumeCandidate& d = candidates[occs[occLit][occInd]];
+							if ((d.m_Signature & ~c.m_Signature) != 0)
+							{
+								continue;
+							}
+
+							const auto [isSubsuming, flippedLit] = SubsumesMarked(d.m_ClsInd);
+							if (!isSubsuming)
+							{
+								continue;
+							}
+
+							if (flippedLit != BadULit)
+							{
+								// Self-subsuming resolution: the clause is strengthened with the resolvent, which subsumes it
+								removedLit = flippedLit;
+							}
+							else if (c.m_IsLearnt || !d.m_IsLearnt)
+							{
+								// A learnt clause mustn't subsume an irredundant one, since it may be deleted later
+								isRemoved = true;
+							}
+						}
+					}
+
+					if (isRemoved || removedLit != BadULit)
+					{
+						break;
+					}
+				}
+
+				if (isRemoved)
+				{
+					assert(NV(2) || P("\tSubsumed: " + SLits(ConstClsSpan(c.m_ClsInd)) + "\n"));
+					++m_Stat.m_IngsSubsumeClssDeleted;
+					DeleteCls(c.m_ClsInd);
+				}
+				else if (removedLit != BadULit)
+				{
+					assert(NV(2) || P("\tStrengthening " + SLits(ConstClsSpan(c.m_ClsInd)) + " by removing " + SLit(removedLit) + "\n"));
+					++m_Stat.m_IngsSubsumeLitsRemoved;
+					litMarks[removedLit] = 0;
+					if (c.m_Size > 3)
+					{
+						DeleteLitFromCls(c.m_ClsInd, removedLit);
+						--c.m_Size;
+						c.m_Signature = Signature(c.m_ClsInd);
+						isStrengthened = true;
+					}
+					else
+					{
+						// The strengthened clause is binary
+						auto cls = Cls(c.m_ClsInd);
+						array<TULit, 2> binCls = { cls[0] == removedLit ? cls[2] : cls[0], cls[1] == removedLit ? cls[2] : cls[1] };
+						DeleteCls(c.m_ClsInd);
+						AddClsToBufferAndWatch(binCls, c.m_IsLearnt, true);
+						if (unlikely(IsUnrecoverable())) return 0;
+						isRemoved = true;
+					}
+				}
+			}
+
+			for (TULit l : clsLits)
+			{
+				litMarks[l] = 0;
+			}
+
+			if (!isRemoved)
+			{
+				// Watch the literal with the fewest occurrences
+				TULit watchLit = BadULit;
+				for (TULit l : Cls(c.m_ClsInd))
+				{
+					if (watchLit == BadULit || occs[l].size() < occs[watchLit].size())
+					{
+						watchLit = l;
+					}
+				}
+				occs[watchLit].push_back(candInd);
+			}
+		}
+	}
+	catch (...)
+	{
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "IngSubsume: allocation failed");
+		return 0;
+	}
+
+	return m_Stat.m_IngsSubsumeClssDeleted + m_Stat.m_IngsSubsumeLitsRemoved - removedBefore;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+bool CTopi<TLit, TUInd, Compress>::IsInprocessingDue() const
+{
+	// If postpone threshold m_ParamIngPostponeFirstInvConflicts not reached --> not due
+	// If postpone threshold reached, but no inprocessing invocations so far --> due ASAP
+	//		Assertion: if inprocessing invoked at least once --> the postpone threashold must have been reached
+	assert(m_Stat.m_Ings == 0 || m_Stat.m_Conflicts >= m_ParamIngPostponeFirstInvConflicts);
+	// Once inprocessing invoked at least once (m_Stat.m_Ings > 0), if the # conflicts since the last inprocessing < m_ParamIngConflictsBeforeNextInvocation,
+	// wait, unless we must invoke after every query (m_ParamIngInvokeEveryQueryAfterInitPostpone) and we haven't invoked for this query yet (m_IngLastSolveInv < m_Stat.m_SolveInvs)
+	return m_ParamInprocessingOn && m_Stat.m_Conflicts >= m_ParamIngPostponeFirstInvConflicts &&
+		(m_Stat.m_Ings == 0 || (m_Stat.m_Conflicts - m_IngLastConflicts) >= m_ParamIngConflictsBeforeNextInvocation ||
+			(m_ParamIngInvokeEveryQueryAfterInitPostpone && m_IngLastSolveInv < m_Stat.m_SolveInvs));
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::InprocessIfRequired()
+{	
+	if (IsUnrecoverable() || m_Status == TToporStatus::STATUS_USER_INTERRUPT || m_DecLevel != m_DecLevelOfLastAssignedAssumption || !IsInprocessingDue())
+	{
+		return;
+	}
+
+	SavedTrailInvalidate();
+	++m_Stat.m_Ings;
+	m_IngLastSolveInv = m_Stat.m_SolveInvs;
+	m_IngLastConflicts = m_Stat.m_Conflicts;
+	
+
+	assert(NV(1) || P("Inprocessing started for time " + to_string(m_Stat.m_Ings) + "; m_SolveInvs = " + to_string(m_IngLastSolveInv) + "; m_Conflicts = " + to_string(m_IngLastConflicts)));
+
+	// The registered techniques, run in this order
+	const TIngTechniqueEntry techniques[] = {
+		{ TIngTechnique::ING_DUPLICATE_BINS, m_ParamExistingBinWLStrat > 2 && m_IngLastEverAddedBinaryClss < m_Stat.m_EverAddedBinaryClss, false, 0., 0, &CTopi::IngRemoveDuplicateBinWatches },
+		{ TIngTechnique::ING_PROBE, m_ParamIngProbe && m_DecLevel == 0, true, m_ParamIngProbeEffort, m_ParamIngProbeMinEffort, &CTopi::IngProbe },
+		{ TIngTechnique::ING_SUBSUME, m_ParamIngSubsume && m_DecLevel == 0, true, m_ParamIngSubsumeEffort, m_ParamIngSubsumeMinEffort, &CTopi::IngSubsume },
+		{ TIngTechnique::ING_VIVIFY, m_ParamIngVivify && m_DecLevel == 0 && m_Stat.m_ActiveLongLearntClss > 0, true, m_ParamIngVivifyEffort, m_ParamIngVivifyMinEffort, &CTopi::IngVivify },
+	};
+
+	for (const TIngTechniqueEntry& te : techniques)
+	{
+		if (te.m_IsOn)
+		{
+			IngRunTechnique(te);
+			if (unlikely(IsUnrecoverable())) return;
+		}
+	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::IngRunTechnique(const TIngTechniqueEntry& te)
+{
+	TIngTechniqueSched& sched = m_IngSched[(size_t)te.m_Technique];
+	auto& stat = m_Stat.m_IngTechniques[(size_t)te.m_Technique];
+
+	const uint64_t implicationsBudget = te.m_IsBudgeted ? max(te.m_MinEffort, (uint64_t)((double)(m_Stat.m_Implications - sched.m_LastImplications) * te.m_Effort * sched.m_EffortScale)) : numeric_limits<uint64_t>::max();
+
+	CTimeMeasure tm;
+	const uint64_t ticksBefore = m_Stat.m_Implications + m_IngSteps;
+	const uint64_t removed = (this->*te.m_Run)(implicationsBudget);
+	const uint64_t ticks = m_Stat.m_Implications + m_IngSteps - ticksBefore;
+
+	++stat.m_Invs;
+	stat.m_Ticks += ticks;
+	stat.m_WallTime += tm.WallTimePassedSinceStartOrResetConst();
+	stat.m_Removed += removed;
+	sched.m_LastImplications = m_Stat.m_Implications;
+
+	if (te.m_IsBudgeted && ticks > 0)
+	{
+		// Scale the effort up or down by the success: the number of clauses and literals removed per million ticks
+		const bool isSuccessful = (double)removed * 1000000. / (double)ticks >= m_ParamIngEffortSuccessThr;
+		sched.m_EffortScale = isSuccessful ? min((double)m_ParamIngEffortScaleMax, sched.m_EffortScale * m_ParamIngEffortScaleFactor) :
+			max((double)m_ParamIngEffortScaleMin, sched.m_EffortScale / m_ParamIngEffortScaleFactor);
+	}
+
+	assert(NV(1) || P("Inprocessing technique " + string(m_Stat.m_IngTechniqueNames[(size_t)te.m_Technique]) + ": budget " + to_string(implicationsBudget) + "; ticks " + to_string(ticks) + "; removed " + to_string(removed) + "; new effort scale " + to_string(sched.m_EffortScale) + "\n"));
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::BveIfRequired(const span<TLit> userAssumps)
+{
+	// The elimination is sound w.r.t the formula only at decision level 0; 
+	// it's not applied, if the internal literals are exposed to the outside world (DRAT, callbacks, parallel solving, debug model verification)
+	if (m_ParamBve == 0 || IsUnrecoverable() || m_DecLevel != 0 || (m_ParamBve == 1 && m_QueryCurr != TQueryType::QUERY_INIT) ||
+		m_Stat.m_AddClauseInvs == m_BveLastAddClauseInvs || UseI2ELitMap() || M_GetNextUnitClause != nullptr)
+	{
+		return;
+	}
+
+	m_BveLastAddClauseInvs = m_Stat.m_AddClauseInvs;
+
+	assert(NV(1) || P("Bounded variable elimination started\n"));
+
+	// The state of an internal variable
+	enum class TBveVarState : uint8_t { NOT_CANDIDATE, CANDIDATE, ELIMINATED };
+	// A clause of the currently eliminated variable: its literals are at [m_First, m_First + m_Size) in bveLits, starting with the eliminated variable's literal
+	struct TBveCls
+	{
+		size_t m_First;
+		size_t m_Size;
+		// BadClsInd for a binary clause
+		TUInd m_ClsInd;
+	};
+
+	uint64_t steps = 0;
+	TContradictionInfo ci;
+
+	try
+	{
+		// Internal variable --> the external literal, corresponding to its positive literal
+		vector<TLit> i2e(GetNextVar(), 0);
+		vector<TBveVarState> varStates(GetNextVar(), TBveVarState::NOT_CANDIDATE);
+		for (TLit vExternal = 1; vExternal <= m_Stat.m_MaxUserVar && (size_t)vExternal < m_E2ILitMap.cap(); ++vExternal)
+		{
+			const TULit l = m_E2ILitMap[vExternal];
+			if (l != BadULit && !IsAssigned(l) && !BveIsEliminated(vExternal))
+			{
+				const TUVar v = GetVar(l);
+				if (i2e[v] != 0)
+				{
+					// Several external variables are mapped to the same internal variable (by equivalent literal substitution), so it can't be reconstructed through one of them
+					varStates[v] = TBveVarState::NOT_CANDIDATE;
+					continue;
+				}
+				i2e[v] = IsNeg(l) ? -vExternal : vExternal;
+				if ((size_t)vExternal >= m_FrozenExtVars.cap() || m_FrozenExtVars[vExternal] == 0)
+				{
+					varStates[v] = TBveVarState::CANDIDATE;
+				}
+			}
+		}
+
+		for (TLit lAssump : userAssumps)
+		{
+			if (lAssump != 0)
+			{
+				varStates[GetVar(E2I(lAssump))] = TBveVarState::NOT_CANDIDATE;
+			}
+		}
+
+		auto GetExtLit = [&](TULit l) { return IsNeg(l) ? -i2e[GetVar(l)] : i2e[GetVar(l)]; };
+		auto BinWatches = [&](TULit l) { return l >= m_Watches.cap() || m_Watches[l].m_BinaryWatches == 0 ? TSpanTULit() : TSpanTULit(m_W.get_ptr(m_Watches[l].m_WBInd) + m_Watches[l].GetLongEntries(), m_Watches[l].m_BinaryWatches); };
+
+		// Occurrence lists for the long irredundant clauses, which aren't globally satisfied (the binary clauses are taken from the watches)
+		vector<vector<TUInd>> occs(GetNextLit());
+		for (TUInd clsInd = ClsLoopFirst(false); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+		{
+			if (ClsChunkDeleted(clsInd) || ClsGetIsLearnt(clsInd))
+			{
+				continue;
+			}
+
+			auto cls = Cls(clsInd);
+			if (any_of(cls.begin(), cls.end(), [&](TULit l) { return IsSatisfied(l); }))
+			{
+				continue;
+			}
+
+			for (TULit l : cls)
+			{
+				if (!IsAssigned(l))
+				{
+					occs[l].push_back(clsInd);
+				}
+			}
+		}
+
+		// The candidates are tried in the ascending order of their (initial) number of occurrences
+		vector<pair<size_t, TUVar>> candidates;
+		for (TUVar v = 1; v < GetNextVar(); ++v)
+		{
+			if (varStates[v] == TBveVarState::CANDIDATE)
+			{
+				const TULit l = GetLit(v, false);
+				candidates.emplace_back(occs[l].size() + occs[Negate(l)].size() + BinWatches(l).size() + BinWatches(Negate(l)).size(), v);
+			}
+		}
+		sort(candidates.begin(), candidates.end());
+
+		vector<TULit> bveLits;
+		array<vector<TBveCls>, 2> sides;
+		vector<TULit> resLits;
+		vector<size_t> resStarts;
+		vector<uint8_t> litMarks(GetNextLit(), 0);
+		vector<TUVar> elimVars;
+		vector<TULit> units;
+
+		// Collect the clauses of l, which aren't globally satisfied, without the globally falsified literals; returns false, if the variable can't be eliminated
+		auto Gather = [&](TULit l, vector<TBveCls>& side)
+		{
+			side.clear();
+			for (TULit otherLit : BinWatches(l))
+			{
+				++steps;
+				if (IsSatisfied(otherLit))
+				{
+					continue;
+				}
+				if (IsAssigned(otherLit) || i2e[GetVar(otherLit)] == 0 || side.size() >= m_ParamBveMaxOccurrences)
+				{
+					return false;
+				}
+				side.push_back(TBveCls{ bveLits.size(), 2, BadClsInd });
+				bveLits.push_back(l);
+				bveLits.push_back(otherLit);
+			}
+
+			for (TUInd clsInd : occs[l])
+			{
+				if (ClsChunkDeleted(clsInd))
+				{
+					continue;
+				}
+
+				const size_t first = bveLits.size();
+				bveLits.push_back(l);
+				bool isSatisfied = false;
+				for (TULit currLit : Cls(clsInd))
+				{
+					++steps;
+					if (IsSatisfied(currLit))
+					{
+						isSatisfied = true;
+						break;
+					}
+					if (currLit != l && !IsFalsified(currLit))
+					{
+						if (i2e[GetVar(currLit)] == 0)
+						{
+							return false;
+						}
+						bveLits.push_back(currLit);
+					}
+				}
+
+				if (isSatisfied)
+				{
+					bveLits.resize(first);
+					continue;
+				}
+
+				// The clause can't be unit or empty after BCP, but to be on the safe side...
+				if (bveLits.size() - first < 2 || side.size() >= m_ParamBveMaxOccurrences)
+				{
+					return false;
+				}
+				side.push_back(TBveCls{ first, bveLits.size() - first, clsInd });
+			}
+
+			return true;
+		};
+
+		// Generate the non-tautological resolvents; returns false, if the variable can't be eliminated
+		auto Resolve = [&]()
+		{
+			resLits.clear();
+			resStarts.clear();
+			const size_t maxResolvents = sides[0].size() + sides[1].size() + m_ParamBveClauseBound;
+			bool isOk = true;
+			for (const TBveCls& posCls : sides[0])
+			{
+				for (size_t i = 1; i < posCls.m_Size; ++i)
+				{
+					litMarks[bveLits[posCls.m_First + i]] = 1;
+				}
+
+				for (const TBveCls& negCls : sides[1])
+				{
+					const size_t resStart = resLits.size();
+					resLits.insert(resLits.end(), bveLits.begin() + posCls.m_First + 1, bveLits.begin() + posCls.m_First + posCls.m_Size);
+					bool isTautology = false;
+					for (size_t i = 1; i < negCls.m_Size; ++i)
+					{
+						++steps;
+						const TULit l = bveLits[negCls.m_First + i];
+						if (litMarks[Negate(l)])
+						{
+							isTautology = true;
+							break;
+						}
+						if (!litMarks[l])
+						{
+							resLits.push_back(l);
+						}
+					}
+
+					if (isTautology)
+					{
+						resLits.resize(resStart);
+						continue;
+					}
+
+					resStarts.push_back(resStart);
+					if (resLits.size() - resStart > m_ParamBveMaxResolventSize || resStarts.size() > maxResolvents)
+					{
+						isOk = false;
+						break;
+					}
+				}
+
+				for (size_t i = 1; i < posCls.m_Size; ++i)
+				{
+					litMarks[bveLits[posCls.m_First + i]] = 0;
+				}
+
+				if (!isOk)
+				{
+					return false;
+				}
+			}
+			resStarts.push_back(resLits.size());
+			return true;
+		};
+
+		for (auto [occsNum, v] : candidates)
+		{
+			if (steps >= m_ParamBveMaxSteps)
+			{
+				break;
+			}
+
+			// The variable might have been assigned by the propagation of the unit resolvents
+			if (IsAssignedVar(v))
+			{
+				continue;
+			}
+
+			const TULit lPos = GetLit(v, false);
+			bveLits.clear();
+			if (!Gather(lPos, sides[0]) || !Gather(Negate(lPos), sides[1]) || !Resolve())
+			{
+				continue;
+			}
+
+			assert(NV(2) || P("BVE: eliminating " + SVar(v) + " by replacing " + to_string(sides[0].size() + sides[1].size()) + " clauses with " + to_string(resStarts.size() - 1) + " resolvents\n"));
+
+			// Store the clauses on the elimination stack, then delete them
+			for (const auto& side : sides)
+			{
+				for (const TBveCls& c : side)
+				{
+					for (size_t i = 0; i < c.m_Size; ++i)
+					{
+						m_BveStack.push_back(GetExtLit(bveLits[c.m_First + i]));
+					}
+					m_BveStack.push_back((TLit)c.m_Size);
+					if (unlikely(m_BveStack.uninitialized_or_erroneous()))
+					{
+						SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "BveIfRequired: couldn't push into m_BveStack");
+						return;
+					}
+
+					if (c.m_ClsInd != BadClsInd)
+					{
+						DeleteCls(c.m_ClsInd);
+					}
+				}
+				m_Stat.m_BveClssRemoved += side.size();
+			}
+
+			// All the binary clauses (including the globally satisfied ones and the duplicates) are removed
+			for (TULit l : { lPos, Negate(lPos) })
+			{
+				for (auto binWatches = BinWatches(l); !binWatches.empty(); binWatches = BinWatches(l))
+				{
+					array<TULit, 2> binCls = { l, binWatches.back() };
+					DeleteBinaryCls(binCls);
+				}
+			}
+
+			// Add the resolvents
+			units.clear();
+			for (size_t i = 0; i + 1 < resStarts.size(); ++i)
+			{
+				const span<TULit> resolvent(resLits.data() + resStarts[i], resStarts[i + 1] - resStarts[i]);
+				if (resolvent.size() == 1)
+				{
+					units.push_back(resolvent[0]);
+					continue;
+				}
+
+				const TUInd clsInd = AddClsToBufferAndWatch(resolvent, false, false);
+				if (unlikely(IsUnrecoverable())) return;
+				if (resolvent.size() > 2)
+				{
+					for (TULit l : resolvent)
+					{
+						occs[l].push_back(clsInd);
+					}
+				}
+			}
+			m_Stat.m_BveResolventsAdded += resStarts.size() - 1;
+
+			varStates[v] = TBveVarState::ELIMINATED;
+			elimVars.push_back(v);
+			++m_Stat.m_BveVarsEliminated;
+
+			if (!units.empty())
+			{
+				for (TULit l : units)
+				{
+					if (Assign(l, BadClsInd, BadULit, 0))
+					{
+						SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by bounded variable elimination");
+						return;
+					}
+				}
+
+				ci = BCP();
+				if (unlikely(IsUnrecoverable())) return;
+				if (ci.IsContradiction())
+				{
+					SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by BCP after bounded variable elimination");
+					return;
+				}
+			}
+		}
+
+		if (elimVars.empty())
+		{
+			assert(NV(1) || P("Bounded variable elimination finished: nothing eliminated\n"));
+			return;
+		}
+
+		// The remaining long clauses with eliminated variables are either learnt or globally satisfied; they're deleted, since the eliminated variables are going to be assigned arbitrarily
+		vector<TUInd> clssToDelete;
+		for (TUInd clsInd = ClsLoopFirst(false); !ClsLoopCompleted(); clsInd = ClsLoopNext())
+		{
+			if (!ClsChunkDeleted(clsInd))
+			{
+				auto cls = Cls(clsInd);
+				if (any_of(cls.begin(), cls.end(), [&](TULit l) { return varStates[GetVar(l)] == TBveVarState::ELIMINATED; }))
+				{
+					clssToDelete.push_back(clsInd);
+				}
+			}
+		}
+		for (TUInd clsInd : clssToDelete)
+		{
+			DeleteCls(clsInd);
+		}
+
+		m_BveElimVals.reserve_atleast((size_t)m_Stat.m_MaxUserVar + 1, (unsigned char)TToporLitVal::VAL_DONT_CARE);
+		if (unlikely(m_BveElimVals.uninitialized_or_erroneous()))
+		{
+			SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "BveIfRequired: couldn't reserve m_BveElimVals");
+			return;
+		}
+
+		// The eliminated variables don't appear in any clauses, so they're assigned at decision level 0, and their actual values are reconstructed for the model
+		for (TUVar v : elimVars)
+		{
+			const TLit vExternal = ExternalLit2ExternalVar(i2e[v]);
+			m_BveElimVals[vExternal] = TToporLitVal::VAL_UNASSIGNED;
+			m_BveElimExtVars.push_back(vExternal);
+			if (unlikely(m_BveElimExtVars.uninitialized_or_erroneous()))
+			{
+				SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "BveIfRequired: couldn't push into m_BveElimExtVars");
+				return;
+			}
+
+			if (!IsAssignedVar(v))
+			{
+				Assign(GetLit(v, true), BadClsInd, BadULit, 0);
+			}
+		}
+	}
+	catch (...)
+	{
+		SetStatus(TToporStatus::STATUS_ALLOC_FAILED, "BveIfRequired: allocation failed");
+		return;
+	}
+
+	ci = BCP();
+	if (unlikely(IsUnrecoverable())) return;
+	if (ci.IsContradiction())
+	{
+		SetStatus(TToporStatus::STATUS_CONTRADICTORY, "Global contradiction: discovered by BCP after bounded variable elimination");
+		return;
+	}
+
+	assert(NV(1) || P("Bounded variable elimination finished: " + to_string(m_Stat.m_BveVarsEliminated) + " variables eliminated so far; " + to_string(steps) + " steps\n"));
+	assert(m_ParamAssertConsistency < 1 || TrailAssertConsistency());
+	assert(m_ParamAssertConsistency < 2 || WLAssertConsistency(false));
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::BveExtendModel()
+{
+	if (m_Status != TToporStatus::STATUS_SAT)
+	{
+		for (TLit vExternal : m_BveElimExtVars.get_const_span())
+		{
+			m_BveElimVals[vExternal] = TToporLitVal::VAL_UNASSIGNED;
+		}
+		return;
+	}
+
+	for (TLit vExternal : m_BveElimExtVars.get_const_span())
+	{
+		m_BveElimVals[vExternal] = TToporLitVal::VAL_UNSATISFIED;
+	}
+
+	auto IsLitSatisfied = [&](TLit l)
+	{
+		return BveIsEliminated(ExternalLit2ExternalVar(l)) ? (m_BveElimVals[ExternalLit2ExternalVar(l)] == TToporLitVal::VAL_SATISFIED) == (l > 0) : GetValue(l) == TToporLitVal::VAL_SATISFIED;
+	};
+
+	// Going backwards over the stack, the witness (the literal of the eliminated variable) of every falsified clause is flipped to satisfy it
+	for (size_t i = m_BveStack.size(); i > 0; )
+	{
+		const size_t clsSize = (size_t)m_BveStack[--i];
+		i -= clsSize;
+		const auto cls = m_BveStack.get_const_span(i, clsSize);
+		if (none_of(cls.begin(), cls.end(), IsLitSatisfied))
+		{
+			m_BveElimVals[ExternalLit2ExternalVar(cls[0])] = cls[0] > 0 ? TToporLitVal::VAL_SATISFIED : TToporLitVal::VAL_UNSATISFIED;
+		}
+	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::BveRestoreAll()
+{
+	if (m_BveElimExtVars.empty())
+	{
+		return;
+	}
+
+	assert(NV(1) || P("Restoring " + to_string(m_BveElimExtVars.size()) + " eliminated variables\n"));
+
+	// The eliminated variables are globally assigned internally, so they'll get new internal variables
+	for (TLit vExternal : m_BveElimExtVars.get_const_span())
+	{
+		m_BveElimVals[vExternal] = TToporLitVal::VAL_DONT_CARE;
+		m_E2ILitMap[vExternal] = BadULit;
+	}
+	m_BveElimExtVars.clear();
+
+	CVector<TLit> bveStack(move(m_BveStack));
+	// The moved-from stack must be reset, since it's going to be reused by future eliminations
+	m_BveStack = CVector<TLit>();
+	m_BveIsRestoring = true;
+	for (size_t i = bveStack.size(); i > 0 && !IsUnrecoverable(); )
+	{
+		const size_t clsSize = (size_t)bveStack[--i];
+		i -= clsSize;
+		AddUserClause(bveStack.get_span(i, clsSize));
+	}
+	m_BveIsRestoring = false;
 }
 
 template class Topor::CTopi<int32_t, uint32_t, false>;
@@ -39,6 +39,28 @@ bool CTopi<TLit,TUInd,Compress>::Restart()
 			m_RstGlueLbdWin.Clear();
 		}
 		break;
+	case RESTART_STRAT_MODES:
+		if ((double)RstModePhaseCounter() >= m_RstModePhaseEnd)
+		{
+			// Switching the mode always comes with a restart
+			RstModeSwitch();
+			restartNow = true;
+		}
+		else if (m_RstModeIsStable)
+		{
+			restartNow = m_ConfsSinceRestart >= m_RstModeStableConfThr;
+			if (restartNow)
+			{
+				// Reluctant doubling
+				m_RstModeStableConfThr = (uint64_t)(RestartLubySequence(2., ++m_RstModeStableRestarts) * (double)m_ParamRestartModesStableLubyUnit);
+			}
+		}
+		else
+		{
+			restartNow = m_ConfsSinceRestart >= m_ParamRestartModesFocusedMinConfs && 
+				m_RstModeGlueEmaFast.GetAverage() > m_ParamRestartModesFocusedMargin * m_RstModeGlueEmaSlow.GetAverage();
+		}
+		break;
 	default:
 		break;
 	}
@@ -81,9 +103,74 @@ bool CTopi<TLit,TUInd,Compress>::Restart()
 	return restartNow;
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+CTopi<TLit, TUInd, Compress>::TUV CTopi<TLit,TUInd,Compress>::RestartBacktrackLevel()
+{
+	if (!m_ParamRestartReuseTrail || m_DecLevel <= m_DecLevelOfLastAssignedAssumption)
+	{
+		return m_DecLevelOfLastAssignedAssumption;
+	}
+
+	TrailCompact();
+	// Inprocessing and simplification run only at the assumption level, so reusing the trail mustn't postpone them, once they're due
+	if (IsInprocessingDue() || IsSimplifyDue())
+	{
+		return m_DecLevelOfLastAssignedAssumption;
+	}
+
+	// Find the next decision candidate (the assigned variables at the top of the heap would have been removed by Decide anyway)
+	TUVar nextVar = BadUVar;
+	if (m_CurrDecisionStrat == DECISION_STRAT_VMTF)
+	{
+		nextVar = m_Vmtf.next_unassigned([&](TUVar v) { return IsAssignedVar(v); });
+	}
+	else
+	{
+		while (!m_VsidsHeap.empty() && IsAssignedVar(m_VsidsHeap.get_min()))
+		{
+			m_VsidsHeap.remove_min();
+		}
+		nextVar = m_VsidsHeap.empty() ? BadUVar : m_VsidsHeap.get_min();
+	}
+
+	if (nextVar == BadUVar)
+	{
+		return m_DecLevelOfLastAssignedAssumption;
+	}
+
+	// A decision level is reused, if its decision variable would still be chosen before the next candidate
+	auto IsPreferredToNext = [&](TUVar v)
+	{
+		return m_CurrDecisionStrat == DECISION_STRAT_VMTF ? m_Vmtf.stamp(v) > m_Vmtf.stamp(nextVar) : m_VsidsHeap.get_var_score(v) >= m_VsidsHeap.get_var_score(nextVar);
+	};
+
+	TUV btLevel = m_DecLevelOfLastAssignedAssumption;
+	while (btLevel < m_DecLevel)
+	{
+		const TUVar decVar = GetDecVar(btLevel + 1);
+		// Stop at collapsed decision levels too
+		if (decVar == BadUVar || !IsAssignedDecVar(decVar) || GetAssignedDecLevelVar(decVar) != btLevel + 1 || !IsPreferredToNext(decVar))
+		{
+			break;
+		}
+		++btLevel;
+	}
+
+	m_Stat.m_RestartsReusedLevels += btLevel - m_DecLevelOfLastAssignedAssumption;
+	return btLevel;
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 void CTopi<TLit,TUInd,Compress>::RstNewAssertingGluedCls(TUV glue)
 {
+	if (m_CurrRestartStrat == RESTART_STRAT_MODES)
+	{
+		// The EMA's are updated in both modes, so that they were up-to-date, when the focused mode is back
+		m_RstModeGlueEmaFast.Update((double)glue);
+		m_RstModeGlueEmaSlow.Update((double)glue);
+		return;
+	}
+
 	assert(m_CurrRestartStrat == RESTART_STRAT_LBD);
 
 	if (m_ParamRestartLbdBlockingEnable)
@@ -129,7 +216,12 @@ void CTopi<TLit,TUInd,Compress>::RestartInit()
 		{
 			InitGlue();
 			assert(NV(1) || P("Restarts initialized to glue\n"));
-		}				
+		}
+		else if (m_CurrRestartStrat == RESTART_STRAT_MODES)
+		{
+			RstModesInit();
+			assert(NV(1) || P("Restarts initialized to mode switching\n"));
+		}
 	}
 	else if (m_ParamRestartStrategyInit != m_ParamRestartStrategyS || m_ParamRestartStrategyInit != m_ParamRestartStrategyN)
 	{
@@ -140,28 +232,36 @@ void CTopi<TLit,TUInd,Compress>::RestartInit()
 		
 		if (m_CurrRestartStrat != prevRestartStrat)
 		{
-			assert(prevRestartStrat == RESTART_STRAT_LBD || prevRestartStrat == RESTART_STRAT_NUMERIC);
-			assert(m_CurrRestartStrat == RESTART_STRAT_LBD || m_CurrRestartStrat == RESTART_STRAT_NUMERIC);
+			assert(prevRestartStrat == RESTART_STRAT_LBD || prevRestartStrat == RESTART_STRAT_NUMERIC || prevRestartStrat == RESTART_STRAT_MODES);
+			assert(m_CurrRestartStrat == RESTART_STRAT_LBD || m_CurrRestartStrat == RESTART_STRAT_NUMERIC || m_CurrRestartStrat == RESTART_STRAT_MODES);
 
-			if (m_CurrRestartStrat == RESTART_STRAT_NUMERIC)
+			if (prevRestartStrat == RESTART_STRAT_LBD)
 			{
-				// LBD --> NUMERIC
-				assert(prevRestartStrat == RESTART_STRAT_LBD);
-				m_RstNumericCurrConfThr = m_Stat.m_Conflicts + m_ParamRestartNumericInitConfThr;		
 				if (m_ParamRestartLbdBlockingEnable)
 				{
 					m_RstGlueBlckAsgnWin.Clear();					
 				}
-				m_RstGlueLbdWin.Clear();		
+				m_RstGlueLbdWin.Clear();
+			}
+
+			if (m_CurrRestartStrat == RESTART_STRAT_NUMERIC)
+			{
+				// LBD or MODES --> NUMERIC
+				m_RstNumericCurrConfThr = m_Stat.m_Conflicts + m_ParamRestartNumericInitConfThr;		
 				assert(NV(1) || P("Restarts switched to arithmetic\n"));
 			}
-			else
+			else if (m_CurrRestartStrat == RESTART_STRAT_LBD)
 			{
-				// NUMERIC --> LBD
-				assert(prevRestartStrat == RESTART_STRAT_NUMERIC);
+				// NUMERIC or MODES --> LBD
 				InitGlue();
 				assert(NV(1) || P("Restarts switched to glue\n"));
 			}
+			else
+			{
+				// NUMERIC or LBD --> MODES
+				RstModesInit();
+				assert(NV(1) || P("Restarts switched to mode switching\n"));
+			}
 		}
 	}	
 
@@ -175,9 +275,121 @@ void CTopi<TLit,TUInd,Compress>::RestartInit()
 
 	m_RestartsSinceInvStart = 0;
 
+	// The target phases are collected anew for every query
+	m_PhaseTargetAssigned = 0;
+	if (m_ParamPhaseRephaseInterval != 0 && m_PhaseRephaseNextConf == 0)
+	{
+		m_PhaseRephaseNextConf = m_Stat.m_Conflicts + m_ParamPhaseRephaseInterval;
+	}
+
 	assert(NV(1) || P("Phase stage set: " + GetPhaseStageStr() + "\n"));
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::PhaseUpdateTargetAndBest(TUV conflictFreeAssigned)
+{
+	assert(IsPhaseTargetOrBestOn());
+	const bool updateTarget = conflictFreeAssigned > m_PhaseTargetAssigned;
+	const bool updateBest = m_ParamPhaseRephaseInterval != 0 && conflictFreeAssigned > m_PhaseBestAssigned;
+	if (!updateTarget && !updateBest)
+	{
+		return;
+	}
+
+	if (updateTarget) m_PhaseTargetAssigned = conflictFreeAssigned;
+	if (updateBest) m_PhaseBestAssigned = conflictFreeAssigned;
+
+	// Copy the saved phases of all the variables, like CaDiCaL (the variables beyond the conflict-free trail hold their saved phases)
+	for (TUVar v = 1; v < GetNextVar(); ++v)
+	{
+		const bool isNegated = m_AssignmentInfo[v].m_IsNegated;
+		if (updateTarget) m_PhaseSavedInfo[v].m_TargetIsNegated = isNegated;
+		if (updateBest) m_PhaseSavedInfo[v].m_BestIsNegated = isNegated;
+	}
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::PhaseRephaseIfRequired()
+{
+	if (m_ParamPhaseRephaseInterval == 0 || m_Stat.m_Conflicts < m_PhaseRephaseNextConf)
+	{
+		return;
+	}
+
+	const TRephaseType rephaseType = m_RephaseCycle[m_PhaseRephases % size(m_RephaseCycle)];
+	++m_PhaseRephases;
+	// The intervals grow arithmetically
+	m_PhaseRephaseNextConf = m_Stat.m_Conflicts + m_PhaseRephases * (uint64_t)m_ParamPhaseRephaseInterval;
+
+	if (rephaseType == TRephaseType::REPHASE_BEST && m_PhaseBestAssigned == 0)
+	{
+		// No best phases since the last best-rephasing
+		return;
+	}
+
+	// Only the saved phases of the unassigned variables can be changed (the assigned ones must be below the assumptions)
+	for (TUVar v = 1; v < GetNextVar(); ++v)
+	{
+		auto& ai = m_AssignmentInfo[v];
+		auto& psi = m_PhaseSavedInfo[v];
+		if (!ai.m_IsAssigned)
+		{
+			ai.m_IsNegated = 
+				rephaseType == TRephaseType::REPHASE_ORIGINAL ? (m_ParamInitPolarityStrat == 0 ? true : m_ParamInitPolarityStrat == 1 ? false : (bool)(rand() % 2)) :
+				rephaseType == TRephaseType::REPHASE_INVERTED ? (m_ParamInitPolarityStrat == 0 ? false : m_ParamInitPolarityStrat == 1 ? true : (bool)(rand() % 2)) :
+				rephaseType == TRephaseType::REPHASE_BEST ? (bool)psi.m_BestIsNegated : (bool)(rand() % 2);
+		}
+		psi.m_TargetIsNegated = ai.m_IsNegated;
+	}
+
+	if (rephaseType == TRephaseType::REPHASE_BEST)
+	{
+		m_PhaseBestAssigned = 0;
+	}
+	m_PhaseTargetAssigned = 0;
+
+	assert(NV(1) || P("Rephased #" + to_string(m_PhaseRephases) + "\n"));
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::RstModesInit()
+{
+	// Start in the focused mode
+	m_RstModeIsStable = false;
+	m_RstModeGlueEmaFast.Init(m_ParamRestartModesFocusedEmaFast);
+	m_RstModeGlueEmaSlow.Init(m_ParamRestartModesFocusedEmaSlow);
+	m_RstModePhaseLen = m_ParamRestartModesPhaseInImplications ? m_ParamRestartModesPhaseImplications : (double)m_ParamRestartModesPhaseConfs;
+	m_RstModePhaseEnd = (double)RstModePhaseCounter() + m_RstModePhaseLen;
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit,TUInd,Compress>::RstModeSwitch()
+{
+	assert(m_CurrRestartStrat == RESTART_STRAT_MODES);
+	m_RstModeIsStable = !m_RstModeIsStable;
+	++m_Stat.m_ModeSwitches;
+
+	if (m_RstModeIsStable)
+	{
+		m_RstModeStableRestarts = 0;
+		m_RstModeStableConfThr = m_ParamRestartModesStableLubyUnit;
+	}
+	else
+	{
+		// A focused-stable pair of phases is over, so the phases grow geometrically
+		m_RstModePhaseLen *= m_ParamRestartModesPhaseGrowth;
+	}
+	m_RstModePhaseEnd = (double)RstModePhaseCounter() + m_RstModePhaseLen;
+	m_PhaseTargetAssigned = 0;
+
+	if (IsRstModeDecisionStrat())
+	{
+		DecisionStratSet(m_RstModeIsStable ? DECISION_STRAT_VSIDS : DECISION_STRAT_VMTF);
+	}
+
+	assert(NV(1) || P("Switched to the " + string(m_RstModeIsStable ? "stable" : "focused") + " mode\n"));
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 double CTopi<TLit,TUInd,Compress>::RestartLubySequence(double y, uint64_t x)
 {
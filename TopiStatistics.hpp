@@ -17,6 +17,16 @@
 
 namespace Topor
 {
+	// The inprocessing techniques, run by the inprocessing scheduler
+	enum class TIngTechnique : uint8_t
+	{
+		ING_DUPLICATE_BINS,
+		ING_VIVIFY,
+		ING_PROBE,
+		ING_SUBSUME,
+		ING_TECHNIQUES_NUM
+	};
+
 	using TGetNum = std::function<size_t()>;
 	using TGetString = std::function<std::string()>;
 	// Statistics, available to the user
@@ -50,9 +60,29 @@ namespace Topor
 			ssStat << print_as_color<IsColor ? ansi_color_code::magenta : ansi_color_code::none>(to_string(Perc(m_Implications, m_Assignments))) << " ";
 			ssStat << print_as_color<IsColor ? ansi_color_code::magenta : ansi_color_code::none>(to_string((double)m_Implications / m_OverallTime.CpuTimePassedSinceStartOrResetConst())) << " ";
 
-			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(" Inprocs DupBins");
+			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(" Inprocs DupBins VivLits VivDels PrbFailed PrbEquivs SubDels SubLits");
 			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_Ings)) << " ";
 			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsDuplicateBinsRemoved)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsVivifyLitsRemoved)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsVivifyClssDeleted)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsProbeFailedLits)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsProbeEquivVars)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsSubsumeClssDeleted)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngsSubsumeLitsRemoved)) << " ";
+			for (size_t t = 0; t < m_IngTechniques.size(); ++t)
+			{
+				const std::string name = m_IngTechniqueNames[t];
+				if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(" " + name + "Invs " + name + "Ticks " + name + "WallT " + name + "Rem");
+				ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngTechniques[t].m_Invs)) << " ";
+				ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngTechniques[t].m_Ticks)) << " ";
+				ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngTechniques[t].m_WallTime, 3)) << " ";
+				ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_IngTechniques[t].m_Removed)) << " ";
+			}
+			
+			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(" BveVars BveClss BveRess");
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_BveVarsEliminated)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_BveClssRemoved)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_BveResolventsAdded)) << " ";
 			
 			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::red : ansi_color_code::none>(" Bufs BufSzMb BufCapMb");
 			ssStat << print_as_color<IsColor ? ansi_color_code::red : ansi_color_code::none>(to_string(M_BGetNum())) << " ";
@@ -97,15 +127,19 @@ namespace Topor
 			ssStat << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(to_string(m_Decisions == 0 ? 0.0 : (double)m_SumOfAllDecLevels / (double)m_Decisions)) << " ";
 			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(" LvlsSvdAsmp");
 			ssStat << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(to_string(m_AssumpReuseBacktrackLevelsSaved)) << " ";
+			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(" TrlSvRpl");
+			ssStat << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(to_string(m_TrailSavingReplayed)) << " ";
 			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::green : ansi_color_code::none>(" RTAsg");
 
 			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(" VSIDSInc VSIDSDecay");
 			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string_scientific(m_VarActivityInc)) << " ";
 			ssStat << print_as_color<IsColor ? ansi_color_code::black : ansi_color_code::none>(to_string(m_VarDecay, 3)) << " ";
 
-			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(" Rsts RstBlocked");
+			if (printHead) ssHead << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(" Rsts RstBlocked ModeSws RstReusedLvls");
 			ssStat << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(to_string(m_Restarts)) << " ";
 			ssStat << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(to_string(m_RestartsBlocked)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(to_string(m_ModeSwitches)) << " ";
+			ssStat << print_as_color<IsColor ? ansi_color_code::bright_cyan : ansi_color_code::none>(to_string(m_RestartsReusedLevels)) << " ";
 
 			++m_ShortStartInv;
 
@@ -150,6 +184,8 @@ namespace Topor
 
 		// The number of backtrack levels, saved by reusing assumptions
 		uint64_t m_AssumpReuseBacktrackLevelsSaved = 0;
+		// The number of implications replayed by trail saving
+		uint64_t m_TrailSavingReplayed = 0;
 		// The sum of all the levels at which a decision was taken
 		uint64_t m_SumOfAllDecLevels = 0;
 		
@@ -200,6 +236,10 @@ namespace Topor
 		uint64_t m_Restarts = 0;
 		// The number of blocked restarts
 		uint64_t m_RestartsBlocked = 0;
+		// The number of decision levels kept by trail-reusing restarts
+		uint64_t m_RestartsReusedLevels = 0;
+		// The number of switches between the focused and the stable modes
+		uint64_t m_ModeSwitches = 0;
 
 		// The number of Simplify invocations
 		uint64_t m_Simplifies = 0;
@@ -208,6 +248,10 @@ namespace Topor
 
 		// The number of literals deleted from clauses by ALL-UIP scheme
 		uint64_t m_LitsRemovedByAllUip = 0;
+		// The number of literals deleted from clauses by shrinking
+		uint64_t m_LitsRemovedByShrinking = 0;
+		// The number of recent learnt clauses, deleted by eager subsumption
+		uint64_t m_LearntsEagerlySubsumed = 0;
 		uint32_t m_AllUipAttempted = 0;
 		uint32_t m_AllUipSucceeded = 0;
 
@@ -215,6 +259,35 @@ namespace Topor
 		uint32_t m_Ings = 0;
 		// The number of duplicate binary clauses, removed by inprocessing
 		uint32_t m_IngsDuplicateBinsRemoved = 0;
+		// The number of literals removed from learnt clauses by vivification
+		uint64_t m_IngsVivifyLitsRemoved = 0;
+		// The number of learnt clauses deleted by vivification, since they're implied by the rest of the formula
+		uint64_t m_IngsVivifyClssDeleted = 0;
+		// The number of failed literals, found by probing
+		uint64_t m_IngsProbeFailedLits = 0;
+		// The number of variables, substituted by their equivalent literals by probing
+		uint64_t m_IngsProbeEquivVars = 0;
+		// The number of long clauses deleted by subsumption
+		uint64_t m_IngsSubsumeClssDeleted = 0;
+		// The number of literals removed from long clauses by self-subsuming resolution (strengthening)
+		uint64_t m_IngsSubsumeLitsRemoved = 0;
+		// Per inprocessing technique: the number of runs, the implications (ticks) and the wall time spent, and the number of clauses and literals removed
+		struct TIngTechniqueStat
+		{
+			uint64_t m_Invs = 0;
+			uint64_t m_Ticks = 0;
+			double m_WallTime = 0.;
+			uint64_t m_Removed = 0;
+		};
+		std::array<TIngTechniqueStat, (size_t)TIngTechnique::ING_TECHNIQUES_NUM> m_IngTechniques = {};
+		static constexpr std::array<const char*, (size_t)TIngTechnique::ING_TECHNIQUES_NUM> m_IngTechniqueNames = { "DupB", "Viv", "Prb", "Sub" };
+
+		// The number of variables eliminated by bounded variable elimination
+		uint64_t m_BveVarsEliminated = 0;
+		// The number of clauses removed by bounded variable elimination
+		uint64_t m_BveClssRemoved = 0;
+		// The number of resolvents added by bounded variable elimination
+		uint64_t m_BveResolventsAdded = 0;
 	protected:
 		template <class T>
 		inline double Perc(T fraction, T total) const { return total == 0 ? 0. : (double)100. * (double)fraction / (double)total; }
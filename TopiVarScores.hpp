@@ -9,7 +9,10 @@
 
 namespace Topor
 {
-	template <typename TUVar, typename TUV>
+	// TScore: the score type (double or float)
+	// Arity: the number of children per heap node; 
+	// the heap is 4-ary by default, so that the children of a node, stored next to their scores, occupy (at most) one cache line
+	template <typename TUVar, typename TUV, typename TScore = double, TUV Arity = 4>
 	class CVarScores 
 	{	
 	public:
@@ -17,8 +20,15 @@ namespace Topor
 		CVarScores(double& varActivityInc) : m_VarActivityInc(varActivityInc), m_Heap(1, 0, 1) 
 		{
 			static_assert(std::is_same<TUVar, TUV>::value);
+			static_assert(std::is_same<TScore, double>::value || std::is_same<TScore, float>::value);
+			static_assert(Arity >= 2);
 		}
 
+		// Rescaling: once a score is higher than RescaleLimit, all the scores are multiplied by RescaleFactor
+		// The float scores are rescaled by a power of 2, which only changes the exponent, so no precision is lost
+		static constexpr TScore RescaleLimit = std::is_same<TScore, float>::value ? (TScore)0x1p100 : (TScore)1e100;
+		static constexpr TScore RescaleFactor = std::is_same<TScore, float>::value ? (TScore)0x1p-100 : (TScore)1e-100;
+
 		void SetInitOrder(bool initOrder)
 		{
 			m_InitOrder = initOrder;
@@ -44,27 +54,80 @@ namespace Topor
 		bool increase_score(TUVar v, double mult = 1.0) 
 		{ 
 			bool isRescaled = false;
-			if (unlikely((m_PosScore[v].m_Score += m_VarActivityInc * mult) > 1e100))
+			if (unlikely((m_PosScore[v].m_Score += (TScore)(m_VarActivityInc * mult)) > RescaleLimit))
 			{
 				span<TPosScore> posScoreSpan = m_PosScore.get_span_cap();
 				// Rescale
 				for (auto& currPosScore : posScoreSpan)
 				{
-					currPosScore.m_Score *= 1e-100;
+					currPosScore.m_Score *= RescaleFactor;
 				}				
 
-				m_VarActivityInc *= 1e-100;
+				for (auto& currEntry : m_Heap.get_span())
+				{
+					currEntry.m_Score *= RescaleFactor;
+				}
+
+				m_VarActivityInc *= RescaleFactor;
 				isRescaled = true;
 			}
 
 			if (in_heap(v))
 			{
+				m_Heap[m_PosScore[v].m_Pos].m_Score = m_PosScore[v].m_Score;
 				percolate_up(m_PosScore[v].m_Pos);
 			}
 
 			return isRescaled;
 		}
 
+		// Set the score to any value (unlike increase_score, the score may decrease); used by learning-rate-based heuristics (not allowed in the bulk reinsertion mode)
+		void update_score(TUVar v, double newScore)
+		{
+			assert(!m_BulkReinsert);
+			const TScore oldScore = m_PosScore[v].m_Score;
+			m_PosScore[v].m_Score = (TScore)newScore;
+			if (in_heap(v))
+			{
+				const TUV pos = m_PosScore[v].m_Pos;
+				m_Heap[pos].m_Score = m_PosScore[v].m_Score;
+				if (m_PosScore[v].m_Score > oldScore)
+				{
+					percolate_up(pos);
+				}
+				else
+				{
+					percolate_down(pos);
+				}
+			}
+		}
+
+		// Multiply all the scores by the same positive factor (the heap property is preserved)
+		void scale_scores(double factor)
+		{
+			assert(factor > 0.);
+			for (auto& currPosScore : m_PosScore.get_span_cap())
+			{
+				currPosScore.m_Score = (TScore)(currPosScore.m_Score * factor);
+			}
+
+			for (auto& currEntry : m_Heap.get_span())
+			{
+				currEntry.m_Score = (TScore)(currEntry.m_Score * factor);
+			}
+		}
+
+		// The maximal score over all the variables, whether in the heap or not
+		TScore get_max_score() const
+		{
+			TScore maxScore = 0;
+			for (const auto& currPosScore : m_PosScore.get_const_span_cap())
+			{
+				maxScore = max(maxScore, currPosScore.m_Score);
+			}
+			return maxScore;
+		}
+
 		void reinsert_if_not_in_heap(TUVar v)
 		{			
 			assert(!uninitialized_or_erroneous());
@@ -72,16 +135,60 @@ namespace Topor
 			if (!in_heap(v))
 			{
 				m_PosScore[v].m_Pos = (TUV)m_Heap.size();
-				m_Heap.push_back(v);				
-				percolate_up(m_PosScore[v].m_Pos);
+				m_Heap.push_back(THeapEntry(m_PosScore[v].m_Score, v));
+				if (!m_BulkReinsert)
+				{
+					percolate_up(m_PosScore[v].m_Pos);
+				}
+			}
+		}
+
+		// Between bulk_reinsert_start and bulk_reinsert_finish, reinsert_if_not_in_heap only appends the variables to the heap array 
+		// (no other heap operation is allowed in the meantime)
+		void bulk_reinsert_start()
+		{
+			assert(!m_BulkReinsert);
+			m_BulkReinsert = true;
+			m_BulkReinsertFirst = (TUV)m_Heap.size();
+		}
+
+		// Restore the heap property bottom-up (as in Floyd's heap construction), but only for the ancestors of the appended variables, level by level, 
+		// which takes O(k + log(n)^2) for k appended variables instead of O(k*log(n)) for k percolate_up's
+		void bulk_reinsert_finish()
+		{
+			assert(m_BulkReinsert);
+			m_BulkReinsert = false;
+			if (m_Heap.size() <= m_BulkReinsertFirst)
+			{
+				return;
+			}
+
+			for (TUV lo = parent(m_BulkReinsertFirst), hi = parent((TUV)m_Heap.size() - 1); hi != 0; lo = parent(lo), hi = parent(hi))
+			{
+				if (parent(hi) + 1 >= lo)
+				{
+					// The ancestors of the current and the next levels meet, so heapify the whole top part of the heap
+					for (TUV i = hi; i != 0; --i)
+					{
+						percolate_down(i);
+					}
+					break;
+				}
+
+				for (TUV i = hi; i >= lo; --i)
+				{
+					percolate_down(i);
+				}
 			}
+
+			assert(heap_property_holds());
 		}
 
 		void rebuild()
 		{
 			m_Heap.reserve_exactly(m_PosScore.cap());
 			m_Heap.clear();
-			m_Heap.emplace_back(0);
+			m_Heap.push_back(THeapEntry(0, 0));
 			for (TUVar v = 1; v < m_PosScore.cap(); ++v)
 			{
 				if (in_heap(v))
@@ -107,16 +214,16 @@ namespace Topor
 			}			
 			assert(!in_heap(v));
 
-			m_PosScore[v] = TPosScore((TUV)m_Heap.size(), score);
-			m_Heap.push_back(v);
+			m_PosScore[v] = TPosScore((TUV)m_Heap.size(), (TScore)score);
+			m_Heap.push_back(THeapEntry((TScore)score, v));
 			percolate_up(m_PosScore[v].m_Pos);
 		}
 
 		TUVar remove_min()
 		{
-			auto v = m_Heap[1];
+			auto v = m_Heap[1].m_Var;
 			swap(m_Heap[1], m_Heap.back());
-			m_PosScore[m_Heap[1]].m_Pos = 1;
+			m_PosScore[m_Heap[1].m_Var].m_Pos = 1;
 			m_PosScore[v].m_Pos = 0;
 			
 			m_Heap.pop_back();
@@ -131,15 +238,15 @@ namespace Topor
 
 		inline TUVar get_min() const
 		{
-			return m_Heap[1];
+			return m_Heap[1].m_Var;
 		}
 
 		inline bool var_score_exists(TUVar v) const { return v < m_PosScore.cap(); }
 
-		inline double get_var_score(TUVar v) const { return m_PosScore[v].m_Score; }
+		inline TScore get_var_score(TUVar v) const { return m_PosScore[v].m_Score; }
 		
 		// Use set_var_score only if rebuild is surely scheduled soon, otherwise it will botch the data structure!
-		inline void set_var_score(TUVar v, double newScore) { m_PosScore[v].m_Score = newScore; }
+		inline void set_var_score(TUVar v, double newScore) { m_PosScore[v].m_Score = (TScore)newScore; }
 
 		inline void var_inc_update(double varDecay) { m_VarActivityInc *= (1. / varDecay); }
 
@@ -157,76 +264,268 @@ namespace Topor
 		// We do the simulation by providing two implementations of the "better" predicate (see below)
 		// See the parameter m_ParamVsidsInitOrder for more details
 		bool m_InitOrder = false;
+		// Are we between bulk_reinsert_start and bulk_reinsert_finish?
+		bool m_BulkReinsert = false;
+		// The heap position of the first variable appended by bulk reinsertion
+		TUV m_BulkReinsertFirst = 0;
+		// A heap entry holds a copy of the variable's score, so that the comparisons wouldn't require accessing m_PosScore
+		struct THeapEntry
+		{
+			THeapEntry(TScore score, TUVar v) : m_Score(score), m_Var(v) {}
+			TScore m_Score;
+			TUVar m_Var;
+		};
 		// Heap of variables
-		CVector<TUVar> m_Heap; 
+		CVector<THeapEntry> m_Heap; 
 
 		// TPosScore: 1) position in the heap (0 means not in the heap); 2) score
 		struct TPosScore
 		{
-			TPosScore(TUV pos, double score) : m_Pos(pos), m_Score(score) {}
+			TPosScore(TUV pos, TScore score) : m_Pos(pos), m_Score(score) {}
 			TUV m_Pos;
-			double m_Score;
+			TScore m_Score;
 		};
 		// Variable-indexed array: position & score per variable
 		CDynArray<TPosScore> m_PosScore;
 
-		// Index "traversal" functions
-		static constexpr TUV left(TUV i) { return i << 1; };
-		static constexpr TUV right(TUV i) { return (i << 1) + 1; };
-		static constexpr TUV parent(TUV i) { return i >> 1; };
+		// Index "traversal" functions (the root is at 1)
+		static constexpr TUV first_child(TUV i) { return Arity * (i - 1) + 2; };
+		// parent(1) == 0, so that walking up from any node ends at 0
+		static constexpr TUV parent(TUV i) { return (i + Arity - 2) / Arity; };
 
 		// Cannot put the static asserts in the class itself, since it's forbidden by C++ standard 
 		// as the functions are undefined inside the class
 		void static_assert_traversal()
 		{
+			static_assert(first_child(1) == 2);
+			static_assert(parent(1) == 0);
 			static_assert(parent(2) == 1);
-			static_assert(parent(3) == 1);
-			static_assert(left(1) == 2);
-			static_assert(right(1) == 3);
-
-			static_assert(parent(4) == 2);
-			static_assert(parent(5) == 2);
-			static_assert(left(2) == 4);
-			static_assert(right(2) == 5);
-
-			static_assert(parent(6) == 3);
-			static_assert(parent(7) == 3);
-			static_assert(left(3) == 6);
-			static_assert(right(3) == 7);
+			static_assert(parent(Arity + 1) == 1);
+			static_assert(parent(Arity + 2) == 2);
+			static_assert(first_child(2) == Arity + 2);
+			static_assert(parent(first_child(3) + Arity - 1) == 3);
 		}
 
 		void percolate_up(TUV i)
 		{
-			const TUVar v = m_Heap[i];
+			const THeapEntry e = m_Heap[i];
 			TUV p = parent(i);
 
-			while (i != 1 && better(v, m_Heap[p])) 
+			while (i != 1 && better(e, m_Heap[p])) 
 			{
 				m_Heap[i] = m_Heap[p];
-				m_PosScore[m_Heap[p]].m_Pos = i;
+				m_PosScore[m_Heap[i].m_Var].m_Pos = i;
 				i = p;
 				p = parent(p);
 			}
-			m_Heap[i] = v;
-			m_PosScore[v].m_Pos = i;
+			m_Heap[i] = e;
+			m_PosScore[e.m_Var].m_Pos = i;
 		}
 
 		void percolate_down(TUV i)
 		{
-			TUVar v = m_Heap[i];
-			while (left(i) < m_Heap.size()) 
+			const THeapEntry e = m_Heap[i];
+			const TUV heapSize = (TUV)m_Heap.size();
+			for (TUV firstChild = first_child(i); firstChild < heapSize; firstChild = first_child(i)) 
 			{
-				auto child = right(i) < m_Heap.size() && 
-					better(m_Heap[right(i)], m_Heap[left(i)]) ? right(i) : left(i);
-				if (!better(m_Heap[child], v)) break;
+				TUV child = firstChild;
+				const TUV childrenEnd = std::min(firstChild + Arity, heapSize);
+				for (TUV currChild = firstChild + 1; currChild < childrenEnd; ++currChild)
+				{
+					if (better(m_Heap[currChild], m_Heap[child]))
+					{
+						child = currChild;
+					}
+				}
+				if (!better(m_Heap[child], e)) break;
 				m_Heap[i] = m_Heap[child];
-				m_PosScore[m_Heap[i]].m_Pos = i;
+				m_PosScore[m_Heap[i].m_Var].m_Pos = i;
 				i = child;
 			}
-			m_Heap[i] = v;
-			m_PosScore[v].m_Pos = i;
+			m_Heap[i] = e;
+			m_PosScore[e.m_Var].m_Pos = i;
+		}
+
+		// For debugging
+		bool heap_property_holds() const
+		{
+			for (TUV i = 1; i < m_Heap.size(); ++i)
+			{
+				if (m_PosScore[m_Heap[i].m_Var].m_Pos != i || m_PosScore[m_Heap[i].m_Var].m_Score != m_Heap[i].m_Score || 
+					(i > 1 && better(m_Heap[i], m_Heap[parent(i)]) && !better(m_Heap[parent(i)], m_Heap[i])))
+				{
+					return false;
+				}
+			}
+			return true;
 		}
 
-		inline bool better(TUVar v1, TUVar v2) const { return m_InitOrder ? m_PosScore[v1].m_Score > m_PosScore[v2].m_Score : m_PosScore[v1].m_Score >= m_PosScore[v2].m_Score; }
+		inline bool better(const THeapEntry& e1, const THeapEntry& e2) const { return m_InitOrder ? e1.m_Score > e2.m_Score : e1.m_Score >= e2.m_Score; }
+	};
+
+	// VMTF (variable-move-to-front) queue: a doubly-linked list of variables, ordered by the time-stamp of their last bump
+	// Bumping moves the variable to the end of the queue in O(1)
+	// The search cursor points to a variable, such that all the variables after it in the queue are assigned, 
+	// so the next decision variable is found by walking back from the cursor
+	template <typename TUVar>
+	class CVmtfQueue
+	{
+	public:
+		void reserve_exactly(size_t beyondMaxVar)
+		{
+			// Must only be used for shrinking after the removed variables have been taken out of the queue
+			m_Links.reserve_exactly(beyondMaxVar, 0);
+		}
+
+		inline bool uninitialized_or_erroneous() const { return m_Links.uninitialized_or_erroneous(); }
+
+		inline bool in_queue(TUVar v) const { return v < m_Links.cap() && m_Links[v].m_Stamp != 0; }
+
+		// Append a new variable to the end of the queue
+		void enqueue(TUVar v)
+		{
+			if (v >= m_Links.cap())
+			{
+				m_Links.reserve_atleast(v + 1, 0);
+				if (uninitialized_or_erroneous())
+				{
+					return;
+				}
+			}
+			assert(!in_queue(v));
+			link_last(v);
+			m_Search = v;
+		}
+
+		// Move the variable to the end of the queue
+		void bump(TUVar v, bool isAssigned)
+		{
+			assert(in_queue(v));
+			if (v != m_Last)
+			{
+				unlink(v);
+				link_last(v);
+			}
+			else
+			{
+				m_Links[v].m_Stamp = ++m_Stamp;
+			}
+
+			// If v is the cursor, it remains the cursor, which is still valid, since nothing follows v
+			if (!isAssigned)
+			{
+				m_Search = v;
+			}
+		}
+
+		// Must be invoked for every unassigned variable to keep the cursor valid
+		// m_Links[BadUVar].m_Stamp is always 0, so an empty cursor is always updated
+		inline void on_unassign(TUVar v)
+		{
+			assert(in_queue(v));
+			if (m_Links[v].m_Stamp > m_Links[m_Search].m_Stamp)
+			{
+				m_Search = v;
+			}
+		}
+
+		// Restart the search from the end of the queue (required, if on_unassign wasn't invoked for some unassigned variables)
+		inline void reset_search() { m_Search = m_Last; }
+
+		// The time-stamp of the variable's last bump (a higher stamp means a more recent bump)
+		inline uint64_t stamp(TUVar v) const { assert(in_queue(v)); return m_Links[v].m_Stamp; }
+
+		// Returns the most recently bumped unassigned variable or BadUVar, if all the variables are assigned
+		template <typename TIsAssigned>
+		TUVar next_unassigned(TIsAssigned IsAssigned)
+		{
+			TUVar v = m_Search;
+			while (v != 0 && IsAssigned(v))
+			{
+				v = m_Links[v].m_Prev;
+			}
+			m_Search = v;
+			return v;
+		}
+
+		// Take the variable out of the queue 
+		void remove(TUVar v)
+		{
+			assert(in_queue(v));
+			if (m_Search == v)
+			{
+				m_Search = m_Links[v].m_Prev;
+			}
+			unlink(v);
+			m_Links[v] = TLink();
+		}
+
+		// Put vTo instead of vFrom in the queue, where vTo must not be in the queue
+		void replace_vars(TUVar vFrom, TUVar vTo)
+		{
+			assert(in_queue(vFrom) && !in_queue(vTo));
+			TLink& l = m_Links[vTo] = m_Links[vFrom];
+			m_Links[vFrom] = TLink();
+			(l.m_Prev == 0 ? m_First : m_Links[l.m_Prev].m_Next) = vTo;
+			(l.m_Next == 0 ? m_Last : m_Links[l.m_Next].m_Prev) = vTo;
+			if (m_Search == vFrom)
+			{
+				m_Search = vTo;
+			}
+		}
+
+		// For debugging: the links and the time-stamps are consistent and the variables after the cursor are assigned
+		template <typename TIsAssigned>
+		bool queue_consistent(TIsAssigned IsAssigned) const
+		{
+			bool afterSearch = m_Search == 0;
+			for (TUVar v = m_First, prev = 0; v != 0; prev = v, v = m_Links[v].m_Next)
+			{
+				if (m_Links[v].m_Prev != prev || (prev != 0 && m_Links[prev].m_Stamp >= m_Links[v].m_Stamp) || (afterSearch && !IsAssigned(v)))
+				{
+					return false;
+				}
+				afterSearch = afterSearch || v == m_Search;
+			}
+			return true;
+		}
+
+		inline void set_multiplier(double multiplier) { m_Links.SetMultiplier(multiplier); }
+
+		inline size_t memMb() const { return m_Links.memMb(); }
+	protected:
+		struct TLink
+		{
+			TUVar m_Prev = 0;
+			TUVar m_Next = 0;
+			// The time-stamp of the last enqueue or bump; 0 means not-in-the-queue
+			uint64_t m_Stamp = 0;
+		};
+		// Variable-indexed array: the previous and the next variables in the queue & the time-stamp
+		CDynArray<TLink> m_Links;
+		// The least and the most recently bumped variables
+		TUVar m_First = 0;
+		TUVar m_Last = 0;
+		// The search cursor
+		TUVar m_Search = 0;
+		// The latest time-stamp
+		uint64_t m_Stamp = 0;
+
+		void unlink(TUVar v)
+		{
+			const TLink& l = m_Links[v];
+			(l.m_Prev == 0 ? m_First : m_Links[l.m_Prev].m_Next) = l.m_Next;
+			(l.m_Next == 0 ? m_Last : m_Links[l.m_Next].m_Prev) = l.m_Prev;
+		}
+
+		void link_last(TUVar v)
+		{
+			TLink& l = m_Links[v];
+			l.m_Prev = m_Last;
+			l.m_Next = 0;
+			l.m_Stamp = ++m_Stamp;
+			(m_Last == 0 ? m_First : m_Links[m_Last].m_Next) = v;
+			m_Last = v;
+		}
 	};
 }
@@ -65,7 +65,7 @@ size_t CTopi<TLit, TUInd, Compress>::WLGetLongWatchInd(TULit l, TUInd clsInd)
 	TWatchInfo& wi = m_Watches[l];
 	for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 	{
-		const TUInd currClsInd = *(TUInd*)(currLongWatchPtr + 1);
+		const TUInd currClsInd = WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1));
 		if (currClsInd == clsInd)
 		{
 			return currLongWatchInd;
@@ -82,7 +82,7 @@ void CTopi<TLit, TUInd, Compress>::WLSetCached(TULit l, TUInd clsInd, TULit cach
 	TWatchInfo& wi = m_Watches[l];
 	for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 	{
-		const TUInd currClsInd = *(TUInd*)(currLongWatchPtr + 1);
+		const TUInd currClsInd = WLClsInd(*(TWLClsRef*)(currLongWatchPtr + 1));
 		if (currClsInd == clsInd)
 		{
 			*currLongWatchPtr = cachedLit;
@@ -100,10 +100,11 @@ void CTopi<TLit, TUInd, Compress>::WLReplaceInd(TULit l, TUInd clsInd, TUInd new
 	TWatchInfo& wi = m_Watches[l];
 	for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
 	{
-		TUInd& currClsInd = *(TUInd*)(currLongWatchPtr + 1);
-		if (currClsInd == clsInd)
+		TWLClsRef& currClsRef = *(TWLClsRef*)(currLongWatchPtr + 1);
+		if (WLClsInd(currClsRef) == clsInd)
 		{
-			currClsInd = newClsInd;
+			// Re-encoding the inlined clause information (if any), since it might have changed along with the index
+			currClsRef = WLClsRef(newClsInd);
 			return;
 		}
 	}
@@ -177,7 +178,7 @@ void CTopi<TLit, TUInd, Compress>::WLAddLongWatch(TULit l, TULit inlinedLit, TUI
 	case 0:
 		break;
 	case 1:
-		watchArena[wi.GetUsedEntries() + LitsInInd] = watchArena[wi.GetLongEntries()];
+		watchArena[wi.GetUsedEntries() + LitsInWLClsRef] = watchArena[wi.GetLongEntries()];
 		break;
 	default:
 		if constexpr (TWatchInfo::BinsInLong <= 2)
@@ -201,7 +202,7 @@ void CTopi<TLit, TUInd, Compress>::WLAddLongWatch(TULit l, TULit inlinedLit, TUI
 	// Insert the long watch
 	auto indBeyondLongWatches = wi.GetLongEntries();
 	watchArena[indBeyondLongWatches++] = inlinedLit;
-	*(TUInd*)(watchArena + indBeyondLongWatches) = clsInd;
+	*(TWLClsRef*)(watchArena + indBeyondLongWatches) = WLClsRef(clsInd);
 
 	// Increase the number of long watches in the watch-info
 	++wi.m_LongWatches;
@@ -330,8 +331,12 @@ template <typename TLit, typename TUInd, bool Compress>
 bool CTopi<TLit, TUInd, Compress>::WLAssertNoMissedImplications()
 {
 	auto& b = m_W;
-	for (TUVar v = m_TrailStart; v != BadUVar; v = m_VarInfo[v].m_TrailNext)
+	for (TUVar v : m_Trail.get_span())
 	{
+		if (v == BadUVar)
+		{
+			continue;
+		}
 		const TULit l = Negate(GetAssignedLitForVar(v));
 		TWatchInfo& wi = m_Watches[l];
 
@@ -380,9 +385,13 @@ bool CTopi<TLit, TUInd, Compress>::WLAssertNoMissedImplications()
 		{
 			[[maybe_unused]] const TULit cachedLit = *currLongWatchPtr;
 
-			const TUInd clsInd = *(TUInd*)(currLongWatchPtr + 1);
+			const TWLClsRef clsRef = *(TWLClsRef*)(currLongWatchPtr + 1);
+			const TUInd clsInd = WLClsInd(clsRef);
 			assert(Compress || clsInd < m_B.cap() - 1);
 
+			if (clsRef != WLClsRef(clsInd)) cout << "***ASSERTION-FAILURE Inlined-Cls-Info at " << HexStr(clsRef) << endl;
+			assert(clsRef == WLClsRef(clsInd));
+
 			const auto cls = ConstClsSpan(clsInd);
 
 			if constexpr (!Compress)
@@ -519,9 +528,13 @@ bool CTopi<TLit, TUInd, Compress>::WLAssertConsistency(bool testMissedImplicatio
 		{
 			[[maybe_unused]] const TULit cachedLit = *currLongWatchPtr;
 
-			const TUInd clsInd = *(TUInd*)(currLongWatchPtr + 1);
+			const TWLClsRef clsRef = *(TWLClsRef*)(currLongWatchPtr + 1);
+			const TUInd clsInd = WLClsInd(clsRef);
 			assert(Compress || clsInd < m_B.cap() - 1);
 
+			if (clsRef != WLClsRef(clsInd)) cout << "***ASSERTION-FAILURE Inlined-Cls-Info at " << HexStr(clsRef) << endl;
+			assert(clsRef == WLClsRef(clsInd));
+
 			const auto cls = ConstClsSpan(clsInd);
 
 			if constexpr (!Compress)
@@ -648,6 +661,38 @@ bool CTopi<TLit, TUInd, Compress>::WLIsLitBetter(TULit lCand, TULit lOther) cons
 	}
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopi<TLit, TUInd, Compress>::WLInlineClsInfoInit()
+{
+	if constexpr (!Compress)
+	{
+		const TWLClsRef newClsIndMask = m_ParamWLInlineClsInfo ? WLInlineClsIndMask : numeric_limits<TWLClsRef>::max();
+		if (newClsIndMask == m_WLClsIndMask)
+		{
+			return;
+		}
+
+		if (unlikely(m_BNext > ((TUInd)newClsIndMask << WLClsIndShift)))
+		{
+			SetStatus(TToporStatus::STATUS_INDEX_TOO_NARROW, "WLInlineClsInfoInit: the clause buffer is too large to inline clause information into the watches");
+			return;
+		}
+
+		// Re-encode the clause references of all the existing long watches
+		const TWLClsRef oldClsIndMask = m_WLClsIndMask;
+		m_WLClsIndMask = newClsIndMask;
+		for (TULit l = GetFirstLit(); l < GetNextLit(); ++l)
+		{
+			const TWatchInfo& wi = m_Watches[l];
+			for (auto [currLongWatchInd, currLongWatchPtr] = make_pair((size_t)0, m_W.get_ptr(wi.m_WBInd)); currLongWatchInd < wi.m_LongWatches; ++currLongWatchInd, currLongWatchPtr += TWatchInfo::BinsInLong)
+			{
+				TWLClsRef& clsRef = *(TWLClsRef*)(currLongWatchPtr + 1);
+				clsRef = WLClsRef((TUInd)(clsRef & oldClsIndMask) << WLClsIndShift);
+			}
+		}
+	}
+}
+
 template class Topor::CTopi<int32_t, uint32_t, false>;
 template class Topor::CTopi<int32_t, uint64_t, false>;
 template class Topor::CTopi<int32_t, uint64_t, true>;
@@ -74,6 +74,18 @@ void CTopor<TLit,TUInd,Compress>::ClearUserPolarityInfo(TLit v)
 	m_Topi->ClearUserPolarityInfo(v);
 }
 
+template <typename TLit, typename TUInd, bool Compress>
+void CTopor<TLit, TUInd, Compress>::Freeze(TLit l)
+{
+	m_Topi->Freeze(l);
+}
+
+template <typename TLit, typename TUInd, bool Compress>
+void CTopor<TLit, TUInd, Compress>::Melt(TLit l)
+{
+	m_Topi->Melt(l);
+}
+
 template <typename TLit, typename TUInd, bool Compress>
 void CTopor<TLit,TUInd,Compress>::SetParam(const string& paramName, double newVal)
 {
@@ -61,6 +61,11 @@ namespace Topor
 		void ClearUserPolarityInfo(TLit v); 
 		// Create an internal literal for l: for advanced usages to play with internal literal ordering
 		void CreateInternalLit(TLit l);
+		// Freeze the variable |l|, so that bounded variable elimination (/preprocessing/bve) wouldn't eliminate it; use for the variables, expected to appear in future clauses or assumptions
+		// Freezing is counted: the variable can be eliminated again only after it's melted as many times as it was frozen
+		void Freeze(TLit l);
+		// Melt (unfreeze) the variable |l|
+		void Melt(TLit l);
 		
 		// Dump DRAT
 		void DumpDrat(std::ofstream& openedDratFile, bool isDratBinary, bool dratSortEveryClause);
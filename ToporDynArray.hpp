@@ -285,8 +285,9 @@ namespace Topor
 		}
 
 		template <typename TUInd>
+		// If alignment > 1, every remaining chunk is moved to an aligned index, where AddPadding is expected to fill the gap before the chunk (if any) with garbage
 		void RemoveGarbage(TUInd startInd, TUInd& endInd, function<bool(TUInd clsInd)> IsChunkDeleted, function<TUInd(TUInd clsInd)> ChunkEnd,
-			function<void(TUInd oldWlInd, TUInd newWlInd)> NotifyAboutRemainingChunkMove = nullptr)
+			function<void(TUInd oldWlInd, TUInd newWlInd)> NotifyAboutRemainingChunkMove = nullptr, TUInd alignment = 1, function<void(TUInd ind, TUInd padding)> AddPadding = nullptr)
 		{
 			auto FindNextDeleted = [&](TUInd firstInd, TUInd lastInd, function<bool(TUInd clsInd)> IsChunkDeleted, function<TUInd(TUInd clsInd)> ChunkEnd, TUInd toInd = numeric_limits<T>::max(), function<void(TUInd oldWlInd, TUInd newWlInd)> NotifyAboutRemainingChunkMove = nullptr)
 			{
@@ -320,6 +321,16 @@ namespace Topor
 			// Copy chunks from fromInd to toInd
 			while (fromInd < endInd)
 			{
+				if (alignment > 1)
+				{
+					assert((fromInd & (alignment - 1)) == 0);
+					const TUInd padding = (TUInd)(0 - toInd) & (alignment - 1);
+					if (padding != 0)
+					{
+						AddPadding(toInd, padding);
+						toInd += padding;
+					}
+				}
 				TUInd fromIndEnd = FindNextDeleted(fromInd, endInd, IsChunkDeleted, ChunkEnd, toInd, NotifyAboutRemainingChunkMove);
 				const auto copiedInds = fromIndEnd - fromInd;
 				// memmove will still use memcpy, if there is no overlap
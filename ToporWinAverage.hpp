@@ -56,4 +56,37 @@ namespace Topor
 		double m_Sum = 0.;
 		uint16_t m_NextInd = 0;
 	};
+
+	// Exponential moving average with a bias correction for the first values (as in Adam), O(1) space and time per update
+	// Used for CaDiCaL-inspired restart strategies
+	class TEmaAverage
+	{
+	public:
+		TEmaAverage() {}
+		inline void Init(double alpha)
+		{
+			assert(alpha > 0. && alpha <= 1.);
+			m_Alpha = alpha;
+			Clear();
+		}
+		inline void Update(double newVal)
+		{
+			m_Biased += m_Alpha * (newVal - m_Biased);
+			m_Exp *= 1. - m_Alpha;
+		}
+
+		inline double GetAverage() const { return m_Exp == 1. ? 0. : m_Biased / (1. - m_Exp); }
+
+		inline void Clear()
+		{
+			m_Biased = 0.;
+			m_Exp = 1.;
+		}
+	protected:
+		double m_Alpha = 1.;
+		// The biased average
+		double m_Biased = 0.;
+		// (1 - alpha)^updates, used for the bias correction
+		double m_Exp = 1.;
+	};
 }
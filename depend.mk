@@ -0,0 +1,68 @@
+/root/repo/Topi.o /root/repo/Topi.or /root/repo/Topi.od /root/repo/Topi.op: Topi.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h Diamond.h
+/root/repo/TopiAsg.o /root/repo/TopiAsg.or /root/repo/TopiAsg.od /root/repo/TopiAsg.op: TopiAsg.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiBacktrack.o /root/repo/TopiBacktrack.or /root/repo/TopiBacktrack.od /root/repo/TopiBacktrack.op: TopiBacktrack.cc Topi.hpp TopiStatistics.hpp \
+ TimeMeasure.h BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiBcp.o /root/repo/TopiBcp.or /root/repo/TopiBcp.od /root/repo/TopiBcp.op: TopiBcp.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiBitCompression.o /root/repo/TopiBitCompression.or /root/repo/TopiBitCompression.od /root/repo/TopiBitCompression.op: TopiBitCompression.cc Topi.hpp TopiStatistics.hpp \
+ TimeMeasure.h BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiCompression.o /root/repo/TopiCompression.or /root/repo/TopiCompression.od /root/repo/TopiCompression.op: TopiCompression.cc Topi.hpp TopiStatistics.hpp \
+ TimeMeasure.h BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiConflictAnalysis.o /root/repo/TopiConflictAnalysis.or /root/repo/TopiConflictAnalysis.od /root/repo/TopiConflictAnalysis.op: TopiConflictAnalysis.cc Topi.hpp \
+ TopiStatistics.hpp TimeMeasure.h BasicMemoryUsage.h \
+ ToporExternalTypes.hpp ColorPrint.h ToporBitArrayBuffer.hpp \
+ ToporTableBitInfo.hpp ToporDynArray.hpp ToporBitArray.hpp \
+ ToporVector.hpp TopiParams.hpp TopiVarScores.hpp ToporWinAverage.hpp \
+ SetInScope.h
+/root/repo/TopiDebugPrinting.o /root/repo/TopiDebugPrinting.or /root/repo/TopiDebugPrinting.od /root/repo/TopiDebugPrinting.op: TopiDebugPrinting.cc Topi.hpp TopiStatistics.hpp \
+ TimeMeasure.h BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiDecision.o /root/repo/TopiDecision.or /root/repo/TopiDecision.od /root/repo/TopiDecision.op: TopiDecision.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiInprocess.o /root/repo/TopiInprocess.or /root/repo/TopiInprocess.od /root/repo/TopiInprocess.op: TopiInprocess.cc Topi.hpp TopiStatistics.hpp \
+ TimeMeasure.h BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiRestart.o /root/repo/TopiRestart.or /root/repo/TopiRestart.od /root/repo/TopiRestart.op: TopiRestart.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/TopiWL.o /root/repo/TopiWL.or /root/repo/TopiWL.od /root/repo/TopiWL.op: TopiWL.cc Topi.hpp TopiStatistics.hpp TimeMeasure.h \
+ BasicMemoryUsage.h ToporExternalTypes.hpp ColorPrint.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/Topor.o /root/repo/Topor.or /root/repo/Topor.od /root/repo/Topor.op: Topor.cc Topor.hpp ToporExternalTypes.hpp ColorPrint.h Topi.hpp \
+ TopiStatistics.hpp TimeMeasure.h BasicMemoryUsage.h \
+ ToporBitArrayBuffer.hpp ToporTableBitInfo.hpp ToporDynArray.hpp \
+ ToporBitArray.hpp ToporVector.hpp TopiParams.hpp TopiVarScores.hpp \
+ ToporWinAverage.hpp SetInScope.h
+/root/repo/ToporIpasir.o /root/repo/ToporIpasir.or /root/repo/ToporIpasir.od /root/repo/ToporIpasir.op: ToporIpasir.cc ToporIpasir.h Topor.hpp \
+ ToporExternalTypes.hpp ColorPrint.h